@@ -0,0 +1,260 @@
+// Micro-benchmarks for the C++ matching core. Built as a separate executable
+// (orderbook_bench) so it runs without the profiler or any data files.
+#include "OrderBook.hpp"
+#include "OrderPool.hpp"
+#include "MbpFeed.hpp"
+#include "PositionLedger.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The pre-split resting order: every order padded out to its own cache line
+struct alignas(64) LegacyOrder {
+    uint64_t orderId;
+    double price;
+    double size;
+    bool isBuy;
+    char padding[39];
+};
+
+constexpr size_t kCacheLine = 64;
+
+template <typename Setup, typename Fn>
+double bestNsPerOp(size_t ops, int reps, Setup&& setup, Fn&& fn) {
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        setup();
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::nano> elapsed = end - start;
+        if (elapsed.count() < best) best = elapsed.count();
+    }
+    return best / ops;
+}
+
+volatile uint64_t sink;
+
+// Sweep one price level front to back, filling every resting order completely,
+// the way matchOrder walks a level for a large aggressor
+double sweepLegacy(size_t n, int reps) {
+    std::vector<LegacyOrder> level(n);
+    auto refill = [&] {
+        for (size_t i = 0; i < n; ++i) {
+            level[i].orderId = i + 1;
+            level[i].size = 1.0;
+        }
+    };
+    return bestNsPerOp(n, reps, refill, [&] {
+        double incoming = static_cast<double>(n);
+        uint64_t ids = 0;
+        for (size_t i = 0; i < n && incoming > 0; ++i) {
+            double fill = std::min(incoming, level[i].size);
+            incoming -= fill;
+            level[i].size -= fill;
+            ids += level[i].orderId;
+        }
+        sink = ids;
+    });
+}
+
+// The same sweep through the pool's block queue: an indexed scan over each block's id and
+// size arrays, stepping to the next block every kBlockOrders orders
+double sweepBlocks(size_t n, int reps) {
+    OrderPool pool(n);
+    PriceLevel level;
+    auto refill = [&] {
+        pool.clear();
+        level = PriceLevel();
+        for (size_t i = 0; i < n; ++i) pool.pushBack(level, 6800000, false, i + 1, 1);
+    };
+    return bestNsPerOp(n, reps, refill, [&] {
+        uint64_t ids = 0;
+        pool.consumeFront(level, static_cast<Qty>(n), [&](uint64_t orderId, Qty, bool) { ids += orderId; });
+        sink = ids;
+    });
+}
+
+// Full engine path: rest n asks on one level, then take them all with a single buy
+double sweepBook(size_t n, int reps) {
+    return bestNsPerOp(n, reps, [] {}, [&] {
+        OrderBook ob(SymbolSpec{"BENCH", 0.01, 1e-8}, n);
+        for (size_t i = 0; i < n; ++i) ob.processOrderTicks(false, 6800000, 1);
+        ob.processOrderTicks(true, 6800000, static_cast<Qty>(n));
+        sink = static_cast<uint64_t>(ob.getBestAsk());
+    });
+}
+
+// Synthetic tape: orders scattered +/-500 ticks around a drifting mid, about a third crossing
+std::vector<OrderRequest> makeTape(size_t n) {
+    std::mt19937_64 rng(42);
+    std::vector<OrderRequest> tape(n);
+    Price mid = 6800000;
+    for (auto& req : tape) {
+        mid += static_cast<Price>(rng() % 3) - 1;
+        req.isBuy = rng() & 1;
+        Price offset = static_cast<Price>(rng() % 500);
+        req.price = req.isBuy ? mid - offset + 150 : mid + offset - 150;
+        req.size = 1 + static_cast<Qty>(rng() % 100);
+    }
+    return tape;
+}
+
+double replaySingle(const std::vector<OrderRequest>& tape, int reps) {
+    return bestNsPerOp(tape.size(), reps, [] {}, [&] {
+        OrderBook ob(SymbolSpec{"BENCH", 0.01, 1e-8}, tape.size());
+        for (const auto& req : tape) ob.processOrderTicks(req.isBuy, req.price, req.size);
+        sink = static_cast<uint64_t>(ob.bestBidTicks());
+    });
+}
+
+double replayBatched(const std::vector<OrderRequest>& tape, size_t batchSize, int reps) {
+    return bestNsPerOp(tape.size(), reps, [] {}, [&] {
+        OrderBook ob(SymbolSpec{"BENCH", 0.01, 1e-8}, tape.size());
+        std::span<const OrderRequest> all(tape);
+        for (size_t i = 0; i < all.size(); i += batchSize) {
+            ob.processBatch(all.subspan(i, std::min(batchSize, all.size() - i)));
+        }
+        sink = static_cast<uint64_t>(ob.bestBidTicks());
+    });
+}
+
+// Batched replay with level changes streamed to an MbpFeed and drained in-thread after
+// every batch, as a consumer on the same core would
+double replayWithFeed(const std::vector<OrderRequest>& tape, size_t batchSize, int reps, uint64_t& updates) {
+    return bestNsPerOp(tape.size(), reps, [] {}, [&] {
+        MbpFeed feed(1 << 16);
+        BasicOrderBook<MbpFeedListener> ob(SymbolSpec{"BENCH", 0.01, 1e-8}, tape.size(), MbpFeedListener{&feed});
+        std::span<const OrderRequest> all(tape);
+        uint64_t checksum = 0;
+        for (size_t i = 0; i < all.size(); i += batchSize) {
+            ob.processBatch(all.subspan(i, std::min(batchSize, all.size() - i)));
+            feed.publish();
+            feed.consume([&](std::span<const MbpUpdate> block) {
+                for (const MbpUpdate& u : block) checksum += static_cast<uint64_t>(u.totalSize);
+            });
+        }
+        updates = feed.lastSequence();
+        sink = checksum;
+    });
+}
+
+// Batched replay with a PositionLedger on the book. After every batch a strategy order (a
+// copy of the batch's first row) goes in through the ledger as immediate-or-cancel and the
+// position is marked to mid. A far-off strategy bid stays working throughout, so every
+// fill on the book is looked up in the ledger's owned ids.
+double replayWithLedger(const std::vector<OrderRequest>& tape, size_t batchSize, int reps, uint64_t& fills) {
+    const SymbolSpec spec{"BENCH", 0.01, 1e-8};
+    PositionLedger ledger(spec, FeeSchedule{0.0020, 0.0040});
+    return bestNsPerOp(tape.size(), reps, [&] { ledger.reset(); }, [&] {
+        BasicOrderBook<LedgerListener> ob(spec, tape.size(), LedgerListener{&ledger});
+        ledger.submit(ob, true, tape.front().price - 10000, 1);
+        std::span<const OrderRequest> all(tape);
+        for (size_t i = 0; i < all.size(); i += batchSize) {
+            ob.processBatch(all.subspan(i, std::min(batchSize, all.size() - i)));
+            ledger.cancel(ob, ledger.submit(ob, all[i].isBuy, all[i].price, all[i].size));
+            ledger.mark(ob.bestBidTicks(), ob.bestAskTicks());
+        }
+        fills = ledger.stats().fills;
+        sink = static_cast<uint64_t>(ledger.equity());
+    });
+}
+
+} // namespace
+
+int main() {
+    std::cout << "==========================================================\n";
+    std::cout << " C++ ORDERBOOK MICRO-BENCHMARKS\n";
+    std::cout << "==========================================================\n\n";
+
+    std::cout << "[1] Resting order layout\n";
+    std::cout << " -> Legacy Order:   " << sizeof(LegacyOrder) << " B, "
+              << std::fixed << std::setprecision(2) << double(kCacheLine) / sizeof(LegacyOrder) << " orders/cache line\n";
+    constexpr size_t kPerOrder = sizeof(OrderBlock) / kBlockOrders;
+    std::cout << " -> OrderBlock:     " << kPerOrder << " B/order, " << double(kCacheLine) / kPerOrder
+              << " orders/cache line (+" << sizeof(OrderBlockInfo) << " B OrderBlockInfo per " << kBlockOrders
+              << " orders)\n";
+    std::cout << " -> 1,000-order level: " << 1000 * sizeof(LegacyOrder) / 1024 << " KB -> "
+              << 1000 * kPerOrder / 1024 << " KB swept\n\n";
+
+    std::cout << "[2] Level sweep throughput (fill every order at one price)\n";
+    for (size_t n : {size_t(1000), size_t(100000), size_t(4000000)}) {
+        int reps = n > 1000000 ? 5 : 50;
+        double legacy = sweepLegacy(n, reps);
+        double blocks = sweepBlocks(n, reps);
+        std::cout << " -> " << std::setw(9) << n << " orders: legacy " << std::setprecision(3) << legacy
+                  << " ns/order, blocks " << blocks << " ns/order (" << std::setprecision(2) << legacy / blocks
+                  << "x)\n";
+    }
+    std::cout << "\n";
+
+    std::cout << "[3] End-to-end OrderBook sweep (rest n asks, one crossing buy)\n";
+    for (size_t n : {size_t(1000), size_t(100000)}) {
+        double ns = sweepBook(n, 20);
+        std::cout << " -> " << std::setw(9) << n << " orders: " << std::setprecision(3) << ns
+                  << " ns/order (" << std::setprecision(0) << 1e9 / ns << " orders/sec)\n";
+    }
+    std::cout << "\n";
+
+    std::cout << "[4] Tape replay: processOrderTicks per row vs processBatch\n";
+    auto tape = makeTape(1000000);
+    double single = replaySingle(tape, 5);
+    std::cout << " -> per-call:        " << std::setprecision(3) << single << " ns/order\n";
+    for (size_t batchSize : {size_t(10), size_t(256), size_t(4096)}) {
+        double batched = replayBatched(tape, batchSize, 5);
+        std::cout << " -> batch of " << std::setw(5) << batchSize << ": " << std::setprecision(3) << batched
+                  << " ns/order (" << std::setprecision(2) << single / batched << "x)\n";
+    }
+    std::cout << "\n";
+
+    std::cout << "[5] Market-by-price feed overhead (batch of 256)\n";
+    uint64_t updates = 0;
+    double plain = replayBatched(tape, 256, 5);
+    double withFeed = replayWithFeed(tape, 256, 5, updates);
+    std::cout << " -> no listener: " << std::setprecision(3) << plain << " ns/order, with feed: " << withFeed
+              << " ns/order\n";
+    std::cout << " -> " << updates << " deltas x " << sizeof(MbpUpdate) << " B = "
+              << updates * sizeof(MbpUpdate) / 1024 << " KB for " << tape.size() << " orders\n";
+    std::cout << "\n";
+
+    std::cout << "[6] Fill-driven position ledger (batch of 10, one strategy order per batch)\n";
+    uint64_t fills = 0;
+    double batchedTen = replayBatched(tape, 10, 5);
+    double withLedger = replayWithLedger(tape, 10, 5, fills);
+    std::cout << " -> no listener: " << std::setprecision(3) << batchedTen << " ns/order, with ledger: " << withLedger
+              << " ns/order (" << std::setprecision(0) << 1e9 / withLedger << " orders/sec)\n";
+    std::cout << " -> " << fills << " strategy fills booked\n";
+    std::cout << "\n";
+
+    std::cout << "[7] Warm start: checkpoint restore vs replaying the tape\n";
+    {
+        const std::string path = "orderbook_bench.ckpt";
+        OrderBook source(SymbolSpec{"BENCH", 0.01, 1e-8}, tape.size());
+        source.processBatch(tape);
+        auto t0 = std::chrono::high_resolution_clock::now();
+        bool saved = source.saveCheckpoint(path);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        OrderBook restored(SymbolSpec{"BENCH", 0.01, 1e-8}, tape.size());
+        bool loaded = restored.loadCheckpoint(path);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        std::remove(path.c_str());
+        std::chrono::duration<double, std::milli> saveMs = t1 - t0, loadMs = t2 - t1;
+        double replayMs = plain * tape.size() / 1e6;
+        if (!saved || !loaded || restored.bestBidTicks() != source.bestBidTicks()) {
+            std::cout << " -> checkpoint round trip FAILED\n";
+        } else {
+            std::cout << " -> save " << std::setprecision(2) << saveMs.count() << " ms, restore " << loadMs.count()
+                      << " ms vs replay " << replayMs << " ms (" << std::setprecision(0) << replayMs / loadMs.count()
+                      << "x)\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,36 @@
+#ifndef BOOKEVENTS_HPP
+#define BOOKEVENTS_HPP
+
+#include "SymbolSpec.hpp"
+#include <cstdint>
+
+// A single fill between an incoming (aggressor) order and a resting order.
+// Trades always print at the resting order's price.
+struct Trade {
+    uint64_t aggressorId;
+    uint64_t restingId;
+    Price price;
+    Qty size;
+    bool aggressorIsBuy;
+};
+
+// Event-listener policy for BasicOrderBook. The book calls these hooks inline from the
+// matching path, so a listener with empty bodies compiles away entirely and a real one
+// costs only what its bodies do -- no virtual dispatch, no event queue.
+//
+//   onTrade        every fill, in execution order
+//   onAdd          an order (or its remainder) starts resting on the book
+//   onCancel       resting quantity removed without trading; qty is the amount removed,
+//                  so a size-down amend reports the reduction while the order keeps resting
+//   onLevelChange  a level's aggregate size changed (0 means the level is gone); reported
+//                  once per level per event rather than per fill
+//
+// A custom listener implements all four with the same signatures.
+struct NullBookListener {
+    void onTrade(const Trade&) {}
+    void onAdd(uint64_t /*orderId*/, bool /*isBuy*/, Price /*price*/, Qty /*qty*/) {}
+    void onCancel(uint64_t /*orderId*/, bool /*isBuy*/, Price /*price*/, Qty /*qty*/) {}
+    void onLevelChange(bool /*isBid*/, Price /*price*/, Qty /*newTotalSize*/) {}
+};
+
+#endif
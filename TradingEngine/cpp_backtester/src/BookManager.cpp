@@ -0,0 +1,107 @@
+#include "BookManager.hpp"
+#include <algorithm>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+// Cores to pin `count` shards to: those this process may run on, except the one the
+// calling (producer) thread is on right now. Empty when that leaves fewer than `count`,
+// since a spinning loop sharing a core with another loop or the producer is worse off
+// pinned than left to the scheduler.
+std::vector<int> shardCores(size_t count) {
+    std::vector<int> cores;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return cores;
+    const int producer = sched_getcpu();
+    // Walk from the core after the producer's and wrap around
+    for (int offset = 1; offset < CPU_SETSIZE && cores.size() < count; ++offset) {
+        int core = (std::max(producer, 0) + offset) % CPU_SETSIZE;
+        if (core != producer && CPU_ISSET(core, &allowed)) cores.push_back(core);
+    }
+    if (cores.size() < count) cores.clear();
+#else
+    (void)count;
+#endif
+    return cores;
+}
+
+} // namespace
+
+bool SymbolTable::intern(const std::string& symbol, SymbolId& out) {
+    auto it = ids.find(symbol);
+    if (it != ids.end()) {
+        out = it->second;
+        return true;
+    }
+    if (names.size() == kMaxSymbols) return false;
+    out = static_cast<SymbolId>(names.size());
+    ids.emplace(symbol, out);
+    names.push_back(symbol);
+    return true;
+}
+
+bool SymbolTable::lookup(const std::string& symbol, SymbolId& out) const {
+    auto it = ids.find(symbol);
+    if (it == ids.end()) return false;
+    out = it->second;
+    return true;
+}
+
+BookManager::BookManager(size_t shardCount) {
+    shardCount = std::max<size_t>(shardCount, 1);
+    shards.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        shards.push_back(std::make_unique<MatchingLoop>());
+    }
+}
+
+BookManager::~BookManager() {
+    stop();
+}
+
+bool BookManager::addSymbol(const SymbolSpec& spec, SymbolId& out, size_t orderCapacity) {
+    if (symbols.lookup(spec.symbol, out)) return true;
+    if (!symbols.intern(spec.symbol, out)) return false;
+
+    uint32_t shard = static_cast<uint32_t>(out % shards.size());
+    routes.push_back(Route{shard, shards[shard]->addBook(spec, orderCapacity)});
+    return true;
+}
+
+void BookManager::start(bool pinCores) {
+    std::vector<int> cores;
+    if (pinCores) cores = shardCores(shards.size());
+    for (size_t i = 0; i < shards.size(); ++i) {
+        shards[i]->start(cores.empty() ? -1 : cores[i]);
+    }
+}
+
+void BookManager::stop() {
+    for (auto& shard : shards) shard->stop();
+}
+
+void BookManager::drain() {
+    // Publish every shard first so they all work in parallel while we wait on each
+    for (auto& shard : shards) shard->publish();
+    for (auto& shard : shards) shard->drain();
+}
+
+void BookManager::resetBooks() {
+    for (auto& shard : shards) {
+        for (uint32_t i = 0; i < shard->bookCount(); ++i) shard->book(i).reset();
+    }
+}
+
+OrderBook& BookManager::book(SymbolId symbol) {
+    const Route& route = routes[symbol];
+    return shards[route.shard]->book(route.localBook);
+}
+
+const OrderBook& BookManager::book(SymbolId symbol) const {
+    const Route& route = routes[symbol];
+    return shards[route.shard]->book(route.localBook);
+}
@@ -0,0 +1,94 @@
+#ifndef BOOKMANAGER_HPP
+#define BOOKMANAGER_HPP
+
+#include "MatchingLoop.hpp"
+#include "OrderBook.hpp"
+#include "SymbolSpec.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Dense id for an interned symbol, used for routing instead of string compares/hashes
+using SymbolId = uint16_t;
+
+// Interns symbol names to SymbolIds in registration order
+class SymbolTable {
+private:
+    std::unordered_map<std::string, SymbolId> ids;
+    std::vector<std::string> names;
+
+public:
+    // Every SymbolId value can name a symbol
+    static constexpr size_t kMaxSymbols = size_t{1} << (8 * sizeof(SymbolId));
+
+    // Returns false, interning nothing, if the symbol is new and all kMaxSymbols ids are taken
+    bool intern(const std::string& symbol, SymbolId& out);
+    // Returns false if the symbol was never interned
+    bool lookup(const std::string& symbol, SymbolId& out) const;
+    const std::string& name(SymbolId id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+};
+
+// Owns one OrderBook per symbol and spreads them across shards, each a MatchingLoop with
+// its own thread. Symbols are assigned to shards round-robin at
+// registration and never move, so a book is only ever touched by its shard's thread and
+// needs no locking. Orders are routed into the owning shard's SPSC ring and matched
+// there; a multi-symbol tape therefore scales with the number of shards instead of
+// running on one thread.
+//
+// Usage: addSymbol() for every symbol, start(), submit() from a single router thread,
+// drain() to wait for the shards to catch up, then read books via book(). Reading a book
+// is only safe after drain() (or stop()) while no further orders are being submitted.
+class BookManager {
+public:
+    explicit BookManager(size_t shardCount);
+    ~BookManager();
+
+    BookManager(const BookManager&) = delete;
+    BookManager& operator=(const BookManager&) = delete;
+
+    // Registers a symbol (or finds it, if already registered). Returns false once the
+    // symbol table is full.
+    bool addSymbol(const SymbolSpec& spec, SymbolId& out, size_t orderCapacity = 1 << 16);
+    bool findSymbol(const std::string& symbol, SymbolId& out) const { return symbols.lookup(symbol, out); }
+    const SymbolTable& symbolTable() const { return symbols; }
+    size_t shardCount() const { return shards.size(); }
+    size_t shardOf(SymbolId symbol) const { return routes[symbol].shard; }
+
+    // Starts every shard. With pinCores, each shard's thread is pinned to its own core,
+    // leaving the caller's core to the producer; if there are not enough cores for that,
+    // the shards run unpinned (Linux only).
+    void start(bool pinCores = false);
+    void stop();
+
+    // Queues an order on its symbol's shard. The ring publishes in blocks, so the
+    // shard only sees new orders once per block or on drain().
+    void submit(SymbolId symbol, const OrderRequest& order) {
+        const Route& route = routes[symbol];
+        shards[route.shard]->submit(route.localBook, order);
+    }
+
+    // Publishes everything staged and blocks until every shard has processed it
+    void drain();
+
+    // Empties every book (see OrderBook::reset), e.g. between replay passes. Like reading
+    // a book, only safe after drain() (or stop()) while nothing is being submitted.
+    void resetBooks();
+
+    OrderBook& book(SymbolId symbol);
+    const OrderBook& book(SymbolId symbol) const;
+
+private:
+    struct Route {
+        uint32_t shard;
+        uint32_t localBook;
+    };
+
+    SymbolTable symbols;
+    std::vector<Route> routes; // indexed by SymbolId
+    std::vector<std::unique_ptr<MatchingLoop>> shards;
+};
+
+#endif
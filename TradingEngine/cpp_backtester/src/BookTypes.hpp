@@ -0,0 +1,78 @@
+#ifndef BOOKTYPES_HPP
+#define BOOKTYPES_HPP
+
+#include "SymbolSpec.hpp"
+#include <cstdint>
+
+// Orders are referenced by their slot in the OrderPool rather than by pointer,
+// so links stay valid if the pool ever has to grow and are half the size.
+using NodeId = uint32_t;
+constexpr NodeId kNullNode = UINT32_MAX;
+
+// An order as it arrives at the matcher (and the remainder that may come to rest)
+struct Order {
+    uint64_t orderId;
+    Price price; // ticks
+    Qty size;    // lots
+    bool isBuy;
+};
+
+// Batch submission record (see BasicOrderBook::processBatch), already in ticks/lots
+struct OrderRequest {
+    Price price;
+    Qty size;
+    bool isBuy;
+};
+
+// Per-order outcome of a batch: how much traded immediately and how much now rests
+struct OrderResult {
+    uint64_t orderId;
+    Qty filled;
+    Qty resting;
+};
+
+// A level's time-priority queue is a chain of OrderBlocks, each holding the level's next
+// kBlockOrders orders in arrival order as two parallel arrays: ids and remaining sizes. That
+// is 16 bytes an order, four to a cache line against one for the old padded 64-byte Order,
+// and a sweep within a block is an indexed scan the CPU can run ahead on rather than a
+// walk that waits on every order's `next` link. The block's links, price and side live in
+// a parallel OrderBlockInfo array and are read once per block, not per order.
+//
+// A filled or cancelled order leaves a zero-size hole that sweeps skip, and a block goes
+// back to the pool once its last live order does. A resting order is addressed by its
+// slot, block * kBlockOrders + position, which is what the id index stores.
+constexpr uint32_t kBlockOrders = 16;
+
+struct alignas(64) OrderBlock {
+    uint64_t orderIds[kBlockOrders];
+    Qty sizes[kBlockOrders]; // lots; 0 = filled or cancelled
+};
+static_assert(sizeof(OrderBlock) == 256, "a block should be exactly four cache lines");
+
+struct OrderBlockInfo {
+    Price price; // ticks
+    // Neighbouring blocks in the level's queue (next doubles as the free-list link)
+    NodeId prev;
+    NodeId next;
+    uint16_t begin; // slots before this one have been consumed from the front
+    uint16_t end;   // slots in use; new orders are appended here
+    uint16_t live;  // orders in [begin, end) with size left
+    bool isBuy;
+};
+
+// Represents a price level in the flat-array orderbook. The orders themselves live in the
+// book's OrderPool; the level only holds the first and last blocks of its queue.
+struct PriceLevel {
+    Price price;
+    Qty totalSize;
+    NodeId head;
+    NodeId tail;
+    uint32_t orderCount;
+
+    PriceLevel() : price(0), totalSize(0), head(kNullNode), tail(kNullNode), orderCount(0) {}
+    PriceLevel(Price p) : price(p), totalSize(0), head(kNullNode), tail(kNullNode), orderCount(0) {}
+
+    bool empty() const { return orderCount == 0; }
+};
+
+#endif
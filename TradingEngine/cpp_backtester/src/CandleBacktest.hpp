@@ -0,0 +1,117 @@
+#ifndef CANDLEBACKTEST_HPP
+#define CANDLEBACKTEST_HPP
+
+#include "CandleSeries.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+// Annualized Sharpe ratio from the sum and sum of squares of n per-trade returns (0 for
+// fewer than two)
+inline double sharpeFromSums(double sum, double sq_sum, size_t n) {
+    if (n <= 1) return 0.0;
+    double mean = sum / n;
+    double stdev = std::sqrt(sq_sum / n - mean * mean);
+    return stdev > 0 ? (mean / stdev) * std::sqrt(252) : 0.0;
+}
+
+inline double sharpeRatio(std::span<const double> returns) {
+    double sum = std::accumulate(returns.begin(), returns.end(), 0.0);
+    double sq_sum = std::inner_product(returns.begin(), returns.end(), returns.begin(), 0.0);
+    return sharpeFromSums(sum, sq_sum, returns.size());
+}
+
+struct BacktestStats {
+    int totalTrades = 0;
+    int winningTrades = 0;
+    double totalPnL = 0;
+    double maxDrawdown = 0;
+    double sharpeRatio = 0;
+
+    double winRate() const { return totalTrades > 0 ? (double)winningTrades / totalTrades : 0; }
+};
+
+// Position and PnL bookkeeping for a candle strategy. One position at a time: a buy signal
+// closes any short and goes long at the bar's close, a sell signal closes any long and goes
+// short. Each closed position is one trade, worth its price move times `aggression`.
+class CandleBacktest {
+public:
+    explicit CandleBacktest(double aggression) : aggression(aggression) {}
+
+    // Acts on bar i's signal (1 = buy, -1 = sell, 0 = hold) at its close
+    void onBar(int signal, double close) {
+        if (signal == 1 && position <= 0) {
+            if (position == -1) closeTrade((entryPrice - close) * aggression);
+            position = 1;
+            entryPrice = close;
+        } else if (signal == -1 && position >= 0) {
+            if (position == 1) closeTrade((close - entryPrice) * aggression);
+            position = -1;
+            entryPrice = close;
+        }
+        if (totalPnL > peakPnl) peakPnl = totalPnL;
+        double drawdown = peakPnl - totalPnL;
+        if (drawdown > maxDrawdown) maxDrawdown = drawdown;
+    }
+
+    // Closes any open position at `lastClose` (drawdown is not updated); returns true if
+    // there was one
+    bool closeOut(double lastClose) {
+        if (position == 0) return false;
+        closeTrade((position == 1 ? lastClose - entryPrice : entryPrice - lastClose) * aggression);
+        position = 0;
+        return true;
+    }
+
+    // Changes the multiplier applied to trades closed from now on (call while flat)
+    void setAggression(double value) { aggression = value; }
+
+    double pnl() const { return totalPnL; }
+    std::span<const double> tradeReturns() const { return returns; }
+
+    BacktestStats stats() const {
+        return BacktestStats{static_cast<int>(returns.size()), winningTrades, totalPnL, maxDrawdown,
+                             sharpeRatio(returns)};
+    }
+
+private:
+    double aggression;
+    int position = 0; // 0 = flat, 1 = long, -1 = short
+    double entryPrice = 0;
+    double totalPnL = 0;
+    double peakPnl = 0;
+    double maxDrawdown = 0;
+    int winningTrades = 0;
+    std::vector<double> returns;
+
+    void closeTrade(double pnl) {
+        totalPnL += pnl;
+        returns.push_back(pnl);
+        if (pnl > 0) winningTrades++;
+    }
+};
+
+// Feeds bars [begin, end) of a prepared candle strategy (see Strategies.hpp) through
+// `backtest` and closes out at the last one. Indicators are read at absolute bar indices,
+// so a range starting mid-series sees them already warmed up on the bars before it.
+template <typename Strategy>
+void backtestRange(const Strategy& strategy, const CandleSeries& candles, size_t begin, size_t end,
+                   CandleBacktest& backtest) {
+    end = std::min(end, candles.size());
+    for (size_t i = begin; i < end; ++i) backtest.onBar(strategy.signal(i, candles.close[i]), candles.close[i]);
+    if (begin < end) backtest.closeOut(candles.close[end - 1]);
+}
+
+template <typename Strategy>
+BacktestStats backtestCandles(const Strategy& strategy, const CandleSeries& candles, double aggression,
+                              size_t begin = 0, size_t end = SIZE_MAX) {
+    CandleBacktest backtest(aggression);
+    backtestRange(strategy, candles, begin, end, backtest);
+    return backtest.stats();
+}
+
+#endif
@@ -0,0 +1,86 @@
+#include "CandleSeries.hpp"
+#include "ColumnFile.hpp"
+#include "CsvScanner.hpp"
+#include <array>
+#include <vector>
+
+namespace {
+
+struct ParsedCandles {
+    std::vector<int64_t> timestamp;
+    std::vector<double> open, high, low, close, volume;
+
+    void resize(size_t rows) {
+        timestamp.resize(rows);
+        open.resize(rows);
+        high.resize(rows);
+        low.resize(rows);
+        close.resize(rows);
+        volume.resize(rows);
+    }
+};
+
+// timestamp, open, high, low, close, volume
+constexpr std::array<columns::Type, 6> kSchema = {columns::Type::Int64,   columns::Type::Float64,
+                                                  columns::Type::Float64, columns::Type::Float64,
+                                                  columns::Type::Float64, columns::Type::Float64};
+constexpr double kNoScale[2] = {0.0, 0.0};
+
+} // namespace
+
+bool CandleSeries::loadCsv(const std::string& path, unsigned threads) {
+    MappedFile file;
+    if (!file.open(path, MappedFile::Access::Sequential)) return false;
+
+    auto parsedColumns = std::make_shared<ParsedCandles>();
+    ParsedCandles& c = *parsedColumns;
+    bool parsed = csv::parseParallel(csv::skipHeader(file.text()), threads, [&](size_t rows) { c.resize(rows); },
+                                 [&](std::string_view chunk, size_t row) {
+        return csv::forEachLine(chunk, [&](std::string_view line) {
+            csv::Fields fields(line);
+            bool ok = fields.next(c.timestamp[row]) && fields.next(c.open[row]) && fields.next(c.high[row]) &&
+                      fields.next(c.low[row]) && fields.next(c.close[row]) && fields.next(c.volume[row]);
+            ++row;
+            return ok;
+        });
+    });
+    if (!parsed) {
+        *this = CandleSeries();
+        return false;
+    }
+    timestamp = c.timestamp;
+    open = c.open;
+    high = c.high;
+    low = c.low;
+    close = c.close;
+    volume = c.volume;
+    storage = std::move(parsedColumns);
+    return true;
+}
+
+bool CandleSeries::load(const std::string& path, unsigned threads) {
+    columns::SourceStamp source;
+    if (!columns::SourceStamp::of(path, source)) return false;
+    std::string cachePath = columns::cachePathFor(path);
+
+    auto cache = std::make_shared<columns::Reader>();
+    if (cache->open(cachePath, columns::Kind::Candles, kSchema, source, kNoScale)) {
+        timestamp = cache->column<int64_t>(0);
+        open = cache->column<double>(1);
+        high = cache->column<double>(2);
+        low = cache->column<double>(3);
+        close = cache->column<double>(4);
+        volume = cache->column<double>(5);
+        storage = std::move(cache);
+        return true;
+    }
+
+    if (!loadCsv(path, threads)) return false;
+    const columns::ColumnData data[] = {
+        {columns::Type::Int64, timestamp.data()}, {columns::Type::Float64, open.data()},
+        {columns::Type::Float64, high.data()},    {columns::Type::Float64, low.data()},
+        {columns::Type::Float64, close.data()},   {columns::Type::Float64, volume.data()},
+    };
+    columns::write(cachePath, columns::Kind::Candles, source, kNoScale, size(), data);
+    return true;
+}
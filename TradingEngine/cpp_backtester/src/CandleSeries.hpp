@@ -0,0 +1,42 @@
+#ifndef CANDLESERIES_HPP
+#define CANDLESERIES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+// OHLCV history stored column-wise: each field is its own contiguous array indexed by bar,
+// so an indicator over closes streams through close[] alone instead of striding over
+// whole candle records.
+//
+// The columns are read-only views over storage the series shares between its copies:
+// either arrays parsed from the CSV, or the mapped binary cache next to it (see
+// ColumnFile.hpp), in which case loading is an mmap and nothing is parsed or copied.
+struct CandleSeries {
+    std::span<const int64_t> timestamp;
+    std::span<const double> open;
+    std::span<const double> high;
+    std::span<const double> low;
+    std::span<const double> close;
+    std::span<const double> volume;
+
+    size_t size() const { return close.size(); }
+    bool empty() const { return close.empty(); }
+
+    // Replaces the contents with a timestamp,open,high,low,close,volume CSV (header line
+    // skipped). `threads` = 0 picks a worker count from the file size. Returns false if the
+    // file can't be read or a row is malformed.
+    bool loadCsv(const std::string& path, unsigned threads = 0);
+
+    // Like loadCsv, but maps "<path>.cols" when it is current for this CSV, and otherwise
+    // parses the CSV and (re)writes the cache for next time. A cache that can't be written
+    // is not an error.
+    bool load(const std::string& path, unsigned threads = 0);
+
+private:
+    std::shared_ptr<const void> storage;
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "Checkpoint.hpp"
+#include "Crc32c.hpp"
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace checkpoint {
+
+Writer::Writer(const std::string& path) : path(path), tmpPath(path + ".tmp") {
+    file = std::fopen(tmpPath.c_str(), "wb");
+}
+
+Writer::~Writer() {
+    if (file) {
+        std::fclose(file);
+        std::remove(tmpPath.c_str());
+    }
+}
+
+void Writer::put(const void* p, size_t n) {
+    if (!file || n == 0) return;
+    if (std::fwrite(p, 1, n, file) != n) {
+        std::fclose(file);
+        file = nullptr;
+        std::remove(tmpPath.c_str());
+        return;
+    }
+    crc = crc32c(p, n, crc);
+    offset += n;
+}
+
+void Writer::align(size_t to) {
+    static const char zeros[4096] = {};
+    put(zeros, ((offset + to - 1) & ~(to - 1)) - offset);
+}
+
+bool Writer::commit() {
+    // Trailer: the checksum of the payload, padded to keep the file 8-byte aligned
+    const uint32_t payloadCrc = crc;
+    pod(payloadCrc);
+    align();
+    if (!file) return false;
+    bool closed = std::fclose(file) == 0;
+    file = nullptr;
+    if (!closed || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+Reader::~Reader() {
+    if (data) munmap(const_cast<char*>(data), mappedLength);
+}
+
+bool Reader::open(const std::string& path) {
+    if (data) {
+        munmap(const_cast<char*>(data), mappedLength);
+        data = nullptr;
+        good = false;
+    }
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    // Populate up front: the restore reads every page exactly once, so faulting them in
+    // one at a time would cost more than the copies themselves
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    data = static_cast<const char*>(mapped);
+    mappedLength = static_cast<size_t>(st.st_size);
+    pos = 0;
+
+    // The payload is everything before the 8-byte trailer
+    constexpr size_t kTrailer = 8;
+    if (mappedLength < kTrailer || mappedLength % 8 != 0) return false;
+    length = mappedLength - kTrailer;
+    uint32_t stored = 0;
+    std::memcpy(&stored, data + length, sizeof(stored));
+    if (crc32c(data, length) != stored) return false;
+    good = true;
+    return true;
+}
+
+} // namespace checkpoint
@@ -0,0 +1,153 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Flat binary layout for OrderBook checkpoints. A checkpoint is the book's own arrays
+// (pool slab, id index table, ladder levels and occupancy words) written back to back as
+// raw native-endian records, each array 8-byte aligned and prefixed with its element
+// count. Restoring is therefore a handful of bulk copies out of an mmapped file instead
+// of replaying or reparsing orders one by one.
+//
+// The header records the format version and the sizes of the stored record types, so a
+// file written by a build with a different layout is rejected rather than misread. The
+// file ends in a CRC-32C of everything before it, checked before a single field is parsed,
+// so a damaged or hand-edited checkpoint is rejected rather than restored with links that
+// point anywhere.
+// Checkpoints are a cache of a run's state, not an interchange format: they are only
+// valid for the same build layout on the same architecture.
+namespace checkpoint {
+
+constexpr char kMagic[8] = {'T', 'E', 'B', 'O', 'O', 'K', 'C', 'P'};
+constexpr uint32_t kVersion = 4;
+
+// Arrays start at a multiple of their element alignment (at least 8) from the start of the
+// file; the mapping is page-aligned, so the Reader can view them in place
+template <typename T>
+constexpr size_t arrayAlignment() {
+    static_assert(alignof(T) <= 4096, "checkpoint arrays must fit the page alignment of the mapping");
+    return alignof(T) > 8 ? alignof(T) : 8;
+}
+
+// Streams fields to `<path>.tmp` and renames it over `path` on commit(), so a crash or
+// error mid-write never leaves a truncated checkpoint under the real name. Large arrays
+// go straight from the book's memory to the file with no intermediate copy.
+class Writer {
+public:
+    explicit Writer(const std::string& path);
+    ~Writer();
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    bool ok() const { return file != nullptr; }
+
+    template <typename T>
+    void pod(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        put(&value, sizeof(T));
+    }
+
+    template <typename T, typename Alloc>
+    void array(const std::vector<T, Alloc>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        pod(static_cast<uint64_t>(values.size()));
+        align(arrayAlignment<T>());
+        put(values.data(), values.size() * sizeof(T));
+        align();
+    }
+
+    void string(const std::string& s) {
+        pod(static_cast<uint64_t>(s.size()));
+        put(s.data(), s.size());
+        align();
+    }
+
+    // Appends the checksum, then flushes, closes and publishes the file. Returns false if
+    // any write failed.
+    bool commit();
+
+private:
+    std::string path;
+    std::string tmpPath;
+    std::FILE* file = nullptr;
+    size_t offset = 0;
+    uint32_t crc = 0; // of everything put so far
+
+    void put(const void* p, size_t n);
+    void align(size_t to = 8);
+};
+
+// Reads fields back from an mmapped checkpoint. Every read is bounds-checked; after the
+// first failure ok() stays false and further reads do nothing.
+class Reader {
+public:
+    Reader() = default;
+    ~Reader();
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    // Maps the file and verifies its trailing checksum; false if it doesn't match
+    bool open(const std::string& path);
+    bool ok() const { return good; }
+    bool atEnd() const { return good && pos == length; }
+
+    template <typename T>
+    bool pod(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (!take(sizeof(T))) return false;
+        std::memcpy(&value, data + pos - sizeof(T), sizeof(T));
+        return true;
+    }
+
+    // Replaces `values` with the stored array: one bulk copy straight out of the mapping
+    template <typename T, typename Alloc>
+    bool array(std::vector<T, Alloc>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        uint64_t count = 0;
+        if (!pod(count) || !align(arrayAlignment<T>())) return false;
+        if (count > (length - pos) / sizeof(T)) return fail();
+        const T* first = reinterpret_cast<const T*>(data + pos);
+        values.assign(first, first + count);
+        pos += count * sizeof(T);
+        return align();
+    }
+
+    bool string(std::string& s) {
+        uint64_t size = 0;
+        if (!pod(size)) return false;
+        if (size > length - pos) return fail();
+        s.assign(data + pos, size);
+        pos += size;
+        return align();
+    }
+
+    // Marks the image as invalid (for semantic checks made by the caller)
+    bool fail() {
+        good = false;
+        return false;
+    }
+
+private:
+    const char* data = nullptr;
+    size_t mappedLength = 0;
+    size_t length = 0; // the payload, without the checksum trailer
+    size_t pos = 0;
+    bool good = false;
+
+    bool take(size_t n) {
+        if (!good || n > length - pos) return fail();
+        pos += n;
+        return true;
+    }
+    bool align(size_t to = 8) { return take(((pos + to - 1) & ~(to - 1)) - pos); }
+};
+
+} // namespace checkpoint
+
+#endif
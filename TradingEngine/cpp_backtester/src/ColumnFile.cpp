@@ -0,0 +1,128 @@
+#include "ColumnFile.hpp"
+#include "Crc32c.hpp"
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace columns {
+
+namespace {
+
+constexpr char kMagic[8] = {'T', 'E', 'C', 'O', 'L', 'S', '0', '1'};
+constexpr uint32_t kVersion = 2;
+
+size_t elementSize(Type type) {
+    switch (type) {
+        case Type::Int64: return sizeof(int64_t);
+        case Type::Float64: return sizeof(double);
+        case Type::UInt8: return sizeof(uint8_t);
+    }
+    return 0;
+}
+
+size_t alignUp(size_t offset) { return (offset + kAlignment - 1) & ~(kAlignment - 1); }
+
+uint32_t headerCrc(Header header, const void* directory, size_t directoryBytes) {
+    header.crc = 0;
+    return crc32c(directory, directoryBytes, crc32c(&header, sizeof(header)));
+}
+
+} // namespace
+
+bool SourceStamp::of(const std::string& path, SourceStamp& out) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
+    out.size = static_cast<uint64_t>(st.st_size);
+    out.mtimeNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    return true;
+}
+
+bool write(const std::string& path, Kind kind, const SourceStamp& source, const double (&scale)[2], size_t rows,
+           std::span<const ColumnData> columnData) {
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.kind = kind;
+    header.rowCount = rows;
+    header.sourceSize = source.size;
+    header.sourceMtimeNs = source.mtimeNs;
+    header.scale[0] = scale[0];
+    header.scale[1] = scale[1];
+    header.columnCount = static_cast<uint32_t>(columnData.size());
+
+    std::vector<ColumnEntry> directory(columnData.size());
+    size_t offset = alignUp(sizeof(Header) + directory.size() * sizeof(ColumnEntry));
+    for (size_t i = 0; i < columnData.size(); ++i) {
+        const size_t bytes = rows * elementSize(columnData[i].type);
+        directory[i] = ColumnEntry{columnData[i].type, crc32c(columnData[i].data, bytes), offset};
+        offset = alignUp(offset + bytes);
+    }
+    header.crc = headerCrc(header, directory.data(), directory.size() * sizeof(ColumnEntry));
+
+    std::string tmpPath = path + ".XXXXXX";
+    int fd = mkstemp(tmpPath.data());
+    if (fd < 0) return false;
+    // mkstemp creates the file private to us; a cache is as readable as the CSV beside it
+    fchmod(fd, 0644);
+    std::FILE* f = fdopen(fd, "wb");
+    if (!f) {
+        close(fd);
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    static const char zeros[kAlignment] = {};
+    size_t written = 0;
+    auto put = [&](const void* p, size_t n) {
+        if (n > 0 && std::fwrite(p, 1, n, f) != n) return false;
+        written += n;
+        return true;
+    };
+    bool ok = put(&header, sizeof(header)) && put(directory.data(), directory.size() * sizeof(ColumnEntry));
+    for (size_t i = 0; ok && i < columnData.size(); ++i) {
+        ok = put(zeros, directory[i].offset - written) &&
+             put(columnData[i].data, rows * elementSize(columnData[i].type));
+    }
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Reader::open(const std::string& path, Kind kind, std::span<const Type> schema, const SourceStamp& source,
+                  const double (&scale)[2]) {
+    if (!file.open(path, MappedFile::Access::Random) || file.size() < sizeof(Header)) return false;
+
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.kind != kind || header.columnCount != schema.size() || header.sourceSize != source.size ||
+        header.sourceMtimeNs != source.mtimeNs || header.scale[0] != scale[0] || header.scale[1] != scale[1]) {
+        return false;
+    }
+    const size_t directoryBytes = schema.size() * sizeof(ColumnEntry);
+    if (file.size() < sizeof(Header) + directoryBytes ||
+        headerCrc(header, file.data() + sizeof(Header), directoryBytes) != header.crc) {
+        return false;
+    }
+
+    offsets.resize(schema.size());
+    for (size_t i = 0; i < schema.size(); ++i) {
+        ColumnEntry entry;
+        std::memcpy(&entry, file.data() + sizeof(Header) + i * sizeof(ColumnEntry), sizeof(entry));
+        if (entry.type != schema[i] || entry.offset % kAlignment != 0 || entry.offset > file.size()) return false;
+        // Divide rather than multiply: a damaged rowCount must not wrap the byte count
+        // around to something that fits
+        const size_t width = elementSize(schema[i]);
+        if (header.rowCount > (file.size() - entry.offset) / width) return false;
+        const size_t bytes = static_cast<size_t>(header.rowCount) * width;
+        if (crc32c(file.data() + entry.offset, bytes) != entry.crc) return false;
+        offsets[i] = entry.offset;
+    }
+    rowCount = static_cast<size_t>(header.rowCount);
+    return true;
+}
+
+} // namespace columns
@@ -0,0 +1,92 @@
+#ifndef COLUMNFILE_HPP
+#define COLUMNFILE_HPP
+
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// Binary columnar cache for a market-data CSV, stored next to it as "<csv>.cols". The file
+// is a 64-byte header, a column directory, then each column as a raw array starting on a
+// 64-byte boundary, so a loader maps the file and hands out spans straight into it: no
+// parsing and no copying.
+//
+// The header records which CSV (size and mtime) the cache was built from and the scale
+// parameters used to build it (tick/lot sizes for order tapes); a mismatch on either means
+// the cache is stale and the caller regenerates it from the CSV. Like a checkpoint, the
+// file is checksummed (CRC-32C over the header and directory, and one per column), so a
+// torn or corrupted cache is also rejected and rebuilt rather than replayed.
+namespace columns {
+
+enum class Kind : uint32_t { Candles = 1, OrderTape = 2 };
+
+// Element type codes in the column directory
+enum class Type : uint32_t { Int64 = 1, Float64 = 2, UInt8 = 3 };
+
+constexpr size_t kAlignment = 64;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    Kind kind;
+    uint64_t rowCount;
+    uint64_t sourceSize;
+    int64_t sourceMtimeNs;
+    double scale[2];
+    uint32_t columnCount;
+    uint32_t crc; // header (with this field zero) and directory
+};
+static_assert(sizeof(Header) == 64, "column file header is one cache line");
+
+struct ColumnEntry {
+    Type type;
+    uint32_t crc;    // the column's rowCount elements
+    uint64_t offset; // from the start of the file, a multiple of kAlignment
+};
+
+// Identity of the CSV a cache was generated from
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t mtimeNs = 0;
+
+    // False if the file doesn't exist
+    static bool of(const std::string& path, SourceStamp& out);
+};
+
+inline std::string cachePathFor(const std::string& csvPath) { return csvPath + ".cols"; }
+
+// A column handed to write(): its element type and raw bytes
+struct ColumnData {
+    Type type;
+    const void* data;
+};
+
+// Writes a cache file (via a uniquely named temporary in the same directory and a rename,
+// so concurrent writers never share a temporary). All columns have `rows` elements.
+bool write(const std::string& path, Kind kind, const SourceStamp& source, const double (&scale)[2], size_t rows,
+           std::span<const ColumnData> columnData);
+
+// A mapped cache file, validated against the expected kind, schema, source and scales
+class Reader {
+public:
+    bool open(const std::string& path, Kind kind, std::span<const Type> schema, const SourceStamp& source,
+              const double (&scale)[2]);
+
+    size_t rows() const { return rowCount; }
+
+    template <typename T>
+    std::span<const T> column(size_t index) const {
+        return std::span<const T>(reinterpret_cast<const T*>(file.data() + offsets[index]), rowCount);
+    }
+
+private:
+    MappedFile file;
+    size_t rowCount = 0;
+    std::vector<uint64_t> offsets;
+};
+
+} // namespace columns
+
+#endif
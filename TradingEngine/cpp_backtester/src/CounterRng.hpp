@@ -0,0 +1,93 @@
+#ifndef COUNTERRNG_HPP
+#define COUNTERRNG_HPP
+
+#include <array>
+#include <cstdint>
+
+// Counter-based random numbers (Philox4x32-10, Salmon et al., "Parallel Random Numbers: As
+// Easy as 1, 2, 3", SC'11). A value is a pure function of (seed, stream, index): there is
+// no shared or sequential state, so parallel workers can each take their own stream, or
+// jump straight to any position in one, and still get the same numbers as a serial run.
+namespace philox {
+
+using Counter = std::array<uint32_t, 4>;
+using Key = std::array<uint32_t, 2>;
+
+inline void mulhilo(uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo) {
+    uint64_t product = static_cast<uint64_t>(a) * b;
+    hi = static_cast<uint32_t>(product >> 32);
+    lo = static_cast<uint32_t>(product);
+}
+
+// Ten rounds of the Philox4x32 bijection of `ctr` under `key`
+inline Counter philox4x32(Counter ctr, Key key) {
+    for (int round = 0; round < 10; ++round) {
+        uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(0xD2511F53u, ctr[0], hi0, lo0);
+        mulhilo(0xCD9E8D57u, ctr[2], hi1, lo1);
+        ctr = {hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+        key[0] += 0x9E3779B9u;
+        key[1] += 0xBB67AE85u;
+    }
+    return ctr;
+}
+
+} // namespace philox
+
+// A stream of 64-bit random values: value k of stream s under a seed is
+// CounterRng::at(seed, s, k), and next() walks k = 0, 1, 2, ...
+class CounterRng {
+public:
+    CounterRng(uint64_t seed, uint64_t stream) : seed(seed), stream(stream) {}
+
+    // Value `index` of a stream, without a generator
+    static uint64_t at(uint64_t seed, uint64_t stream, uint64_t index) {
+        philox::Counter block = generate(seed, stream, index >> 1);
+        return (index & 1) ? combine(block[2], block[3]) : combine(block[0], block[1]);
+    }
+
+    uint64_t next() {
+        // One Philox block holds two values; the second is kept for the next call
+        if (index & 1) {
+            ++index;
+            return combine(buffered[2], buffered[3]);
+        }
+        buffered = generate(seed, stream, index >> 1);
+        ++index;
+        return combine(buffered[0], buffered[1]);
+    }
+
+    // Uniform in [0, bound) for bound > 0, without modulo bias (Lemire's multiply-shift
+    // with rejection)
+    uint64_t below(uint64_t bound) {
+        unsigned __int128 product = static_cast<unsigned __int128>(next()) * bound;
+        uint64_t low = static_cast<uint64_t>(product);
+        if (low < bound) {
+            uint64_t threshold = -bound % bound;
+            while (low < threshold) {
+                product = static_cast<unsigned __int128>(next()) * bound;
+                low = static_cast<uint64_t>(product);
+            }
+        }
+        return static_cast<uint64_t>(product >> 64);
+    }
+
+    // Uniform in [0, 1) with 53 random bits
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+private:
+    uint64_t seed;
+    uint64_t stream;
+    uint64_t index = 0;
+    philox::Counter buffered{};
+
+    static philox::Counter generate(uint64_t seed, uint64_t stream, uint64_t block) {
+        return philox::philox4x32(
+            {static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32), static_cast<uint32_t>(stream),
+             static_cast<uint32_t>(stream >> 32)},
+            {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)});
+    }
+    static uint64_t combine(uint32_t low, uint32_t high) { return (static_cast<uint64_t>(high) << 32) | low; }
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef CSVSCANNER_HPP
+#define CSVSCANNER_HPP
+
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Building blocks for the market-data loaders: the file is memory-mapped and scanned in
+// place, lines are found with memchr, and numbers are parsed with std::from_chars straight
+// out of the mapping, so loading allocates nothing per line -- no getline buffer, no
+// stringstream, no per-field std::string. Large files are split at line boundaries and the
+// pieces parsed on separate threads directly into their slice of the output columns.
+
+namespace csv {
+
+// Below this much text per worker, threads cost more than they save
+constexpr size_t kMinChunkBytes = 1 << 20;
+
+// Everything after the first (header) line
+inline std::string_view skipHeader(std::string_view text) {
+    size_t eol = text.find('\n');
+    return eol == std::string_view::npos ? std::string_view() : text.substr(eol + 1);
+}
+
+// Calls fn(line) for each non-empty line, without its "\n" or "\r\n"; stops early and
+// returns false as soon as fn does
+template <typename Fn>
+bool forEachLine(std::string_view chunk, Fn&& fn) {
+    const char* p = chunk.data();
+    const char* end = p + chunk.size();
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* lineEnd = eol ? eol : end;
+        const char* trimmed = (lineEnd > p && lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd;
+        if (trimmed > p && !fn(std::string_view(p, static_cast<size_t>(trimmed - p)))) return false;
+        p = lineEnd + 1;
+    }
+    return true;
+}
+
+inline size_t countLines(std::string_view chunk) {
+    size_t rows = 0;
+    forEachLine(chunk, [&](std::string_view) {
+        ++rows;
+        return true;
+    });
+    return rows;
+}
+
+// Sequential comma-separated fields of one line. Each next() consumes a field and the
+// comma after it, failing on anything that isn't exactly one well-formed value.
+class Fields {
+public:
+    explicit Fields(std::string_view line) : p(line.data()), end(line.data() + line.size()) {}
+
+    bool next(double& out) { return number(out); }
+    bool next(int64_t& out) { return number(out); }
+
+    bool next(std::string_view& out) {
+        const char* comma = static_cast<const char*>(std::memchr(p, ',', static_cast<size_t>(end - p)));
+        const char* fieldEnd = comma ? comma : end;
+        out = std::string_view(p, static_cast<size_t>(fieldEnd - p));
+        p = comma ? comma + 1 : end;
+        return true;
+    }
+
+private:
+    const char* p;
+    const char* end;
+
+    template <typename T>
+    bool number(T& out) {
+        auto [ptr, ec] = std::from_chars(p, end, out);
+        if (ec != std::errc()) return false;
+        if (ptr == end) {
+            p = end;
+            return true;
+        }
+        if (*ptr != ',') return false;
+        p = ptr + 1;
+        return true;
+    }
+};
+
+// Splits text into at most `parts` pieces, each ending just after a newline (the last
+// piece takes whatever remains)
+inline std::vector<std::string_view> splitAtLines(std::string_view text, size_t parts) {
+    std::vector<std::string_view> chunks;
+    size_t begin = 0;
+    for (size_t i = 1; i < parts && begin < text.size(); ++i) {
+        size_t target = std::max(begin, text.size() * i / parts);
+        size_t eol = text.find('\n', target);
+        if (eol == std::string_view::npos) break;
+        chunks.push_back(text.substr(begin, eol + 1 - begin));
+        begin = eol + 1;
+    }
+    if (begin < text.size()) chunks.push_back(text.substr(begin));
+    return chunks;
+}
+
+// Parses `body` into row-indexed output columns, on up to `threads` workers (0 = pick from
+// the file size and core count). Each worker counts the rows in its chunk; resize(total) is
+// then called once, and parseChunk(chunk, firstRow) fills rows [firstRow, firstRow + n) of
+// its chunk, returning false on malformed input.
+template <typename Resize, typename ParseChunk>
+bool parseParallel(std::string_view body, unsigned threads, Resize&& resize, ParseChunk&& parseChunk) {
+    if (threads == 0) {
+        size_t bySize = std::max<size_t>(1, body.size() / kMinChunkBytes);
+        threads = static_cast<unsigned>(std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), bySize));
+    }
+    std::vector<std::string_view> chunks = splitAtLines(body, threads);
+    std::vector<size_t> firstRow(chunks.size() + 1, 0);
+
+    if (chunks.size() <= 1) {
+        firstRow.back() = chunks.empty() ? 0 : countLines(chunks[0]);
+        resize(firstRow.back());
+        return chunks.empty() || parseChunk(chunks[0], size_t(0));
+    }
+
+    auto runAll = [&](auto&& work) {
+        std::vector<std::thread> workers;
+        workers.reserve(chunks.size() - 1);
+        for (size_t i = 1; i < chunks.size(); ++i) workers.emplace_back(work, i);
+        work(0);
+        for (auto& worker : workers) worker.join();
+    };
+
+    std::vector<size_t> counts(chunks.size());
+    runAll([&](size_t i) { counts[i] = countLines(chunks[i]); });
+    for (size_t i = 0; i < chunks.size(); ++i) firstRow[i + 1] = firstRow[i] + counts[i];
+    resize(firstRow.back());
+
+    std::vector<char> ok(chunks.size(), 0);
+    runAll([&](size_t i) { ok[i] = parseChunk(chunks[i], firstRow[i]); });
+    return std::all_of(ok.begin(), ok.end(), [](char c) { return c != 0; });
+}
+
+} // namespace csv
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef DEPTHCACHE_HPP
+#define DEPTHCACHE_HPP
+
+#include "PriceLadder.hpp"
+#include "SymbolSpec.hpp"
+#include <array>
+#include <cstddef>
+#include <span>
+
+// One row of an L2 depth view
+struct DepthLevel {
+    Price price; // ticks
+    Qty size;    // lots
+};
+
+// Top-N levels of one side of the book, best first, kept current by the book on every
+// level change instead of being rebuilt on demand. Each update is a scan/shift over at
+// most N contiguous rows; when a cached level disappears, the row that slides in at the
+// bottom comes from the ladder's occupancy bitmap. Readers get a span straight over the
+// cached rows, so querying depth on every event costs nothing beyond the read.
+template <size_t N>
+class DepthCache {
+public:
+    explicit DepthCache(bool isBid) : isBid(isBid) {}
+
+    std::span<const DepthLevel> view() const { return std::span<const DepthLevel>(rows.data(), count); }
+
+    void clear() { count = 0; }
+
+    // Refills the cache from scratch off the ladder (after a restore)
+    void rebuild(const PriceLadder& ladder) {
+        count = 0;
+        ladder.forEachLevel([&](const PriceLevel& level) {
+            rows[count++] = DepthLevel{level.price, level.totalSize};
+            return count < N;
+        });
+    }
+
+    // Applies a level's new aggregate size. `ladder` is this side's ladder; a level that
+    // drops to zero must still be inside its window (it is, until the next recenter).
+    void apply(Price price, Qty newTotalSize, const PriceLadder& ladder) {
+        size_t pos = 0;
+        while (pos < count && isBetter(rows[pos].price, price)) ++pos;
+
+        if (pos < count && rows[pos].price == price) {
+            if (newTotalSize > 0) {
+                rows[pos].size = newTotalSize;
+                return;
+            }
+            // Level gone: close the gap and pull the next level up from the ladder
+            for (size_t i = pos + 1; i < count; ++i) rows[i - 1] = rows[i];
+            --count;
+            if (count == N - 1) {
+                // Search past whichever is worse: the new last row or the emptied level,
+                // which the ladder still reports as occupied at this point
+                Price from = pos < count ? rows[count - 1].price : price;
+                Price next = ladder.nextWorseTick(from);
+                if (next != PriceLadder::kNoTick) {
+                    rows[count++] = DepthLevel{next, ladder.levelAtTick(next).totalSize};
+                }
+            }
+            return;
+        }
+
+        // Not cached: a level beyond the top N, or a new level that belongs inside it
+        if (newTotalSize <= 0 || pos == N) return;
+        size_t last = count < N ? count : N - 1;
+        for (size_t i = last; i > pos; --i) rows[i] = rows[i - 1];
+        rows[pos] = DepthLevel{price, newTotalSize};
+        if (count < N) ++count;
+    }
+
+private:
+    bool isBid;
+    size_t count = 0;
+    std::array<DepthLevel, N> rows{};
+
+    bool isBetter(Price a, Price b) const { return isBid ? a > b : a < b; }
+};
+
+#endif
@@ -0,0 +1,51 @@
+#include "IndicatorCache.hpp"
+#include "IndicatorKernels.hpp"
+
+IndicatorCache::Columns& IndicatorCache::entry(const Key& key, bool& built) {
+    auto [it, inserted] = columns.try_emplace(key);
+    built = !inserted;
+    return it->second;
+}
+
+std::span<const double> IndicatorCache::sma(size_t period) {
+    bool built;
+    Columns& c = entry(Key{Kind::Sma, period, 0, 0}, built);
+    if (!built) {
+        c[0].resize(candles.size());
+        kernels::sma(candles.close, period, c[0]);
+    }
+    return c[0];
+}
+
+std::span<const double> IndicatorCache::rsi(size_t period) {
+    bool built;
+    Columns& c = entry(Key{Kind::Rsi, period, 0, 0}, built);
+    if (!built) {
+        c[0].resize(candles.size());
+        kernels::rsi(candles.close, period, c[0]);
+    }
+    return c[0];
+}
+
+std::pair<std::span<const double>, std::span<const double>> IndicatorCache::bands(size_t period) {
+    bool built;
+    Columns& c = entry(Key{Kind::Bands, period, 0, 0}, built);
+    if (!built) {
+        c[0].resize(candles.size());
+        c[1].resize(candles.size());
+        kernels::rollingStdDev(candles.close, period, c[0], c[1]);
+    }
+    return {c[0], c[1]};
+}
+
+std::pair<std::span<const double>, std::span<const double>> IndicatorCache::macd(size_t fast, size_t slow,
+                                                                                 size_t signal) {
+    bool built;
+    Columns& c = entry(Key{Kind::Macd, fast, slow, signal}, built);
+    if (!built) {
+        c[0].resize(candles.size());
+        c[1].resize(candles.size());
+        kernels::macd(candles.close, fast, slow, signal, c[0], c[1]);
+    }
+    return {c[0], c[1]};
+}
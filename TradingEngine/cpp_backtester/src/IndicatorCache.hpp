@@ -0,0 +1,45 @@
+#ifndef INDICATORCACHE_HPP
+#define INDICATORCACHE_HPP
+
+#include "CandleSeries.hpp"
+#include <array>
+#include <cstddef>
+#include <map>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Indicator columns over one candle series, each computed (with the batch kernels) the
+// first time it is asked for and then shared: a sweep over a hundred configurations that
+// use ten distinct SMA periods computes ten SMA columns. Columns never move once built, so
+// the spans handed out stay valid for the cache's lifetime.
+//
+// Requests are not synchronized; build every column a run needs up front, after which any
+// number of threads can read them.
+class IndicatorCache {
+public:
+    explicit IndicatorCache(const CandleSeries& candles) : candles(candles) {}
+
+    std::span<const double> sma(size_t period);
+    std::span<const double> rsi(size_t period);
+    // Rolling mean and population standard deviation
+    std::pair<std::span<const double>, std::span<const double>> bands(size_t period);
+    // MACD line and signal line
+    std::pair<std::span<const double>, std::span<const double>> macd(size_t fast, size_t slow, size_t signal);
+
+    size_t columnCount() const { return columns.size(); }
+
+private:
+    enum class Kind { Sma, Rsi, Bands, Macd };
+    using Key = std::tuple<Kind, size_t, size_t, size_t>;
+    using Columns = std::array<std::vector<double>, 2>;
+
+    CandleSeries candles;
+    std::map<Key, Columns> columns;
+
+    // The entry for key; `built` is false if it was just created (columns still empty)
+    Columns& entry(const Key& key, bool& built);
+};
+
+#endif
@@ -0,0 +1,173 @@
+#include "IndicatorKernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace kernels {
+
+namespace {
+
+// Outputs are produced in blocks this long; each block's window sums come from a prefix
+// over just the block plus the `period` values before it, which stays in L1/L2 and keeps
+// the partial sums small
+constexpr size_t kBlock = 4096;
+
+// prefix[k] = value(from) + ... + value(from + k - 1), for k in [0, to - from]
+template <typename Value>
+void localPrefix(size_t from, size_t to, Value&& value, std::vector<double>& prefix) {
+    prefix.resize(to - from + 1);
+    double sum = 0.0;
+    prefix[0] = 0.0;
+    for (size_t j = from; j < to; ++j) {
+        sum += value(j);
+        prefix[j - from + 1] = sum;
+    }
+}
+
+// Calls block(begin, end, windowStart) for consecutive output blocks covering
+// [firstOutput, n); windowStart = begin + 1 - period is where that block's prefix starts
+template <typename Block>
+void forEachBlock(size_t firstOutput, size_t n, size_t period, Block&& block) {
+    for (size_t begin = firstOutput; begin < n; begin += kBlock) {
+        block(begin, std::min(n, begin + kBlock), begin + 1 - period);
+    }
+}
+
+} // namespace
+
+void sma(std::span<const double> in, size_t period, std::span<double> out) {
+    const size_t n = std::min(in.size(), out.size());
+    if (period == 0 || n == 0) return;
+    const size_t first = std::min(period - 1, n);
+    std::fill(out.begin(), out.begin() + first, 0.0);
+
+    const double p = static_cast<double>(period);
+    std::vector<double> sums;
+    forEachBlock(first, n, period, [&](size_t begin, size_t end, size_t from) {
+        // Centered on the block's first value, so the sums only carry local price moves
+        const double center = in[begin];
+        localPrefix(from, end, [&](size_t j) { return in[j] - center; }, sums);
+        // The window sum for output i is ends[i - begin] - starts[i - begin]
+        const double* ends = sums.data() + period;
+        const double* starts = sums.data();
+        size_t i = begin;
+#if defined(__AVX2__)
+        const __m256d vCenter = _mm256_set1_pd(center), vPeriod = _mm256_set1_pd(p);
+        for (; i + 4 <= end; i += 4) {
+            __m256d s = _mm256_sub_pd(_mm256_loadu_pd(ends + (i - begin)), _mm256_loadu_pd(starts + (i - begin)));
+            _mm256_storeu_pd(&out[i], _mm256_add_pd(vCenter, _mm256_div_pd(s, vPeriod)));
+        }
+#endif
+        for (; i < end; ++i) out[i] = center + (ends[i - begin] - starts[i - begin]) / p;
+    });
+}
+
+void rollingStdDev(std::span<const double> in, size_t period, std::span<double> mean, std::span<double> stdDev) {
+    const size_t n = std::min({in.size(), mean.size(), stdDev.size()});
+    if (period == 0 || n == 0) return;
+    const size_t first = std::min(period - 1, n);
+    std::fill(mean.begin(), mean.begin() + first, 0.0);
+    std::fill(stdDev.begin(), stdDev.begin() + first, 0.0);
+
+    const double p = static_cast<double>(period);
+    std::vector<double> sums, squares;
+    forEachBlock(first, n, period, [&](size_t begin, size_t end, size_t from) {
+        // Centering keeps x^2 small enough that sum(x^2) - sum(x)^2/n doesn't cancel away
+        // the variance
+        const double center = in[begin];
+        localPrefix(from, end, [&](size_t j) { return in[j] - center; }, sums);
+        localPrefix(from, end, [&](size_t j) {
+            double d = in[j] - center;
+            return d * d;
+        }, squares);
+        const double* ends = sums.data() + period;
+        const double* starts = sums.data();
+        const double* ends2 = squares.data() + period;
+        const double* starts2 = squares.data();
+        size_t i = begin;
+#if defined(__AVX2__)
+        const __m256d vCenter = _mm256_set1_pd(center), vPeriod = _mm256_set1_pd(p), zero = _mm256_setzero_pd();
+        for (; i + 4 <= end; i += 4) {
+            size_t k = i - begin;
+            __m256d s = _mm256_sub_pd(_mm256_loadu_pd(ends + k), _mm256_loadu_pd(starts + k));
+            __m256d s2 = _mm256_sub_pd(_mm256_loadu_pd(ends2 + k), _mm256_loadu_pd(starts2 + k));
+            __m256d var = _mm256_div_pd(_mm256_sub_pd(s2, _mm256_div_pd(_mm256_mul_pd(s, s), vPeriod)), vPeriod);
+            _mm256_storeu_pd(&mean[i], _mm256_add_pd(vCenter, _mm256_div_pd(s, vPeriod)));
+            _mm256_storeu_pd(&stdDev[i], _mm256_sqrt_pd(_mm256_max_pd(var, zero)));
+        }
+#endif
+        for (; i < end; ++i) {
+            size_t k = i - begin;
+            double s = ends[k] - starts[k];
+            double s2 = ends2[k] - starts2[k];
+            double var = (s2 - (s * s) / p) / p;
+            mean[i] = center + s / p;
+            stdDev[i] = std::sqrt(var > 0.0 ? var : 0.0);
+        }
+    });
+}
+
+void rsi(std::span<const double> close, size_t period, std::span<double> out) {
+    const size_t n = std::min(close.size(), out.size());
+    if (period == 0 || n == 0) return;
+    const size_t first = std::min(period, n);
+    std::fill(out.begin(), out.begin() + first, 50.0);
+    if (n <= period) return;
+
+    // Change j is close[j] - close[j-1]. The averages start as the plain mean of the first
+    // `period` changes, at bar `period`, and from then on each change is blended in with
+    // weight 1/period.
+    auto value = [](double gain, double loss) { return loss <= 0.0 ? 100.0 : 100.0 - 100.0 / (1.0 + gain / loss); };
+    const double p = static_cast<double>(period);
+    double gain = 0.0, loss = 0.0;
+    for (size_t j = 1; j <= period; ++j) {
+        double change = close[j] - close[j - 1];
+        gain += std::max(change, 0.0);
+        loss += std::max(-change, 0.0);
+    }
+    gain /= p;
+    loss /= p;
+    out[period] = value(gain, loss);
+    for (size_t i = period + 1; i < n; ++i) {
+        double change = close[i] - close[i - 1];
+        gain = (gain * (p - 1.0) + std::max(change, 0.0)) / p;
+        loss = (loss * (p - 1.0) + std::max(-change, 0.0)) / p;
+        out[i] = value(gain, loss);
+    }
+}
+
+void ema(std::span<const double> in, size_t period, std::span<double> out) {
+    const size_t n = std::min(in.size(), out.size());
+    if (n == 0) return;
+    const double k = 2.0 / (static_cast<double>(period) + 1.0);
+    double value = in[0];
+    out[0] = value;
+    for (size_t i = 1; i < n; ++i) {
+        value = in[i] * k + value * (1.0 - k);
+        out[i] = value;
+    }
+}
+
+void macd(std::span<const double> close, size_t fastPeriod, size_t slowPeriod, size_t signalPeriod,
+          std::span<double> line, std::span<double> signal) {
+    const size_t n = std::min({close.size(), line.size(), signal.size()});
+    if (n == 0) return;
+    const double kFast = 2.0 / (static_cast<double>(fastPeriod) + 1.0);
+    const double kSlow = 2.0 / (static_cast<double>(slowPeriod) + 1.0);
+    const double kSignal = 2.0 / (static_cast<double>(signalPeriod) + 1.0);
+    double fast = close[0], slow = close[0], sig = 0.0;
+    line[0] = 0.0;
+    signal[0] = 0.0;
+    for (size_t i = 1; i < n; ++i) {
+        fast = close[i] * kFast + fast * (1.0 - kFast);
+        slow = close[i] * kSlow + slow * (1.0 - kSlow);
+        line[i] = fast - slow;
+        sig = line[i] * kSignal + sig * (1.0 - kSignal);
+        signal[i] = sig;
+    }
+}
+
+} // namespace kernels
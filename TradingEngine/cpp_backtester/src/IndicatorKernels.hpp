@@ -0,0 +1,47 @@
+#ifndef INDICATORKERNELS_HPP
+#define INDICATORKERNELS_HPP
+
+#include <cstddef>
+#include <span>
+
+// Whole-column indicator kernels: each one takes a price column (e.g. CandleSeries::close)
+// and fills an output column of the same length in one go, so a run that needs an
+// indicator computes the series once up front instead of updating it candle by candle.
+//
+// Windowed sums come from prefix sums: a window is the difference of two prefix entries,
+// which makes every output independent of the one before it. Outputs are done in blocks
+// of a few thousand, each with its own short prefix centered on the block's first price,
+// so the partial sums stay small and cache-resident. The differencing step is vectorized
+// with AVX2 when the target has it, four outputs at a time; the scalar fallback performs
+// the same operations in the same order, so both produce identical columns. That holds
+// only while the compiler doesn't fuse multiply-adds on one path and not the other, which
+// is why this file is built with -ffp-contract=off (see CMakeLists.txt).
+// Wilder's RSI, EMA and MACD are true recurrences and stay scalar.
+//
+// Before a window is full, outputs hold a "not ready" value rather than a partial-window
+// figure: 0 for means and deviations, 50 (neutral) for RSI.
+namespace kernels {
+
+// out[i] = mean of in[i-period+1 .. i]
+void sma(std::span<const double> in, size_t period, std::span<double> out);
+
+// Rolling mean and population standard deviation over `period`, from windowed sums of x
+// and x^2
+void rollingStdDev(std::span<const double> in, size_t period, std::span<double> mean, std::span<double> stdDev);
+
+// Wilder's RSI: average gain and loss over the first `period` close-to-close changes, then
+// smoothed with avg = (avg * (period - 1) + change) / period, so every bar costs the same
+// however long the period is
+void rsi(std::span<const double> close, size_t period, std::span<double> out);
+
+// EMA with alpha = 2 / (period + 1), seeded with in[0]
+void ema(std::span<const double> in, size_t period, std::span<double> out);
+
+// MACD line (fast EMA - slow EMA) and its signal EMA. The signal line starts from zero at
+// bar 0 and is first updated at bar 1.
+void macd(std::span<const double> close, size_t fastPeriod, size_t slowPeriod, size_t signalPeriod,
+          std::span<double> line, std::span<double> signal);
+
+} // namespace kernels
+
+#endif
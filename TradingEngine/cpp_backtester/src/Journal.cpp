@@ -0,0 +1,152 @@
+#include "Journal.hpp"
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ─── Writer ─────────────────────────────────────────────────────────────
+
+JournalWriter::JournalWriter(const std::string& path, const SymbolSpec& spec, size_t bufferRecords)
+    : buffer(std::max<size_t>(bufferRecords, 1)) {
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return;
+
+    JournalHeader header{};
+    std::memcpy(header.magic, kJournalMagic, sizeof(header.magic));
+    header.version = kJournalVersion;
+    header.recordSize = sizeof(JournalRecord);
+    header.tickSize = spec.tickSize;
+    header.lotSize = spec.lotSize;
+    std::memcpy(header.symbol, spec.symbol.data(), std::min(spec.symbol.size(), sizeof(header.symbol) - 1));
+    if (::write(fd, &header, sizeof(header)) != static_cast<ssize_t>(sizeof(header))) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+JournalWriter::~JournalWriter() {
+    flush();
+    if (fd >= 0) ::close(fd);
+}
+
+bool JournalWriter::flush() {
+    if (fd < 0) {
+        staged = 0;
+        return false;
+    }
+    const char* p = reinterpret_cast<const char*>(buffer.data());
+    size_t remaining = staged * sizeof(JournalRecord);
+    staged = 0;
+    while (remaining > 0) {
+        ssize_t n = ::write(fd, p, remaining);
+        if (n <= 0) {
+            ::close(fd);
+            fd = -1;
+            return false;
+        }
+        p += n;
+        remaining -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// ─── Reader ─────────────────────────────────────────────────────────────
+
+JournalReader::~JournalReader() {
+    if (mapping) munmap(mapping, length);
+}
+
+bool JournalReader::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(JournalHeader)) {
+        ::close(fd);
+        return false;
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    JournalHeader header;
+    std::memcpy(&header, mapped, sizeof(header));
+    if (std::memcmp(header.magic, kJournalMagic, sizeof(header.magic)) != 0 || header.version != kJournalVersion ||
+        header.recordSize != sizeof(JournalRecord)) {
+        munmap(mapped, static_cast<size_t>(st.st_size));
+        return false;
+    }
+
+    if (mapping) munmap(mapping, length);
+    mapping = mapped;
+    length = static_cast<size_t>(st.st_size);
+    header.symbol[sizeof(header.symbol) - 1] = '\0';
+    spec = SymbolSpec{header.symbol, header.tickSize, header.lotSize};
+
+    // The header is a multiple of 8 bytes, so records stay aligned within the page-aligned mapping
+    const JournalRecord* first =
+        reinterpret_cast<const JournalRecord*>(static_cast<const char*>(mapping) + sizeof(JournalHeader));
+    size_t count = (length - sizeof(JournalHeader)) / sizeof(JournalRecord);
+    size_t intact = 0;
+    for (; intact < count; ++intact) {
+        JournalRecord record = first[intact];
+        uint32_t stored = record.crc;
+        record.crc = 0;
+        if (record.seq != intact + 1 || crc32c(&record, sizeof(record)) != stored) break;
+    }
+    valid = std::span<const JournalRecord>(first, intact);
+    torn = intact < count || (length - sizeof(JournalHeader)) % sizeof(JournalRecord) != 0;
+    return true;
+}
+
+// ─── Replay ─────────────────────────────────────────────────────────────
+
+JournalReplayer::JournalReplayer(const JournalReader& reader, size_t orderCapacity)
+    : records(reader.records()), truncated(reader.truncated()),
+      orderBook(reader.symbolSpec(), orderCapacity, CheckListener{this}) {}
+
+void JournalReplayer::checkTrade(const Trade& trade) {
+    if (cursor < records.size() && records[cursor].type == JournalRecordType::Trade) {
+        const JournalRecord& expected = records[cursor++];
+        if (expected.orderId == trade.aggressorId && expected.restingId == trade.restingId &&
+            expected.price == trade.price && expected.size == trade.size &&
+            static_cast<bool>(expected.isBuy) == trade.aggressorIsBuy) {
+            ++stats.tradesMatched;
+            return;
+        }
+    }
+    ++stats.mismatches;
+}
+
+JournalReplayStats JournalReplayer::run() {
+    stats = JournalReplayStats{};
+    stats.truncated = truncated;
+    cursor = 0;
+    while (cursor < records.size()) {
+        const JournalRecord& record = records[cursor++];
+        switch (record.type) {
+            case JournalRecordType::NewOrder:
+                if (orderBook.processOrderTicks(record.isBuy, record.price, record.size) != record.orderId) {
+                    ++stats.mismatches;
+                }
+                break;
+            case JournalRecordType::Cancel:
+                orderBook.cancelOrder(record.orderId);
+                break;
+            case JournalRecordType::Amend:
+                orderBook.amendOrderTicks(record.orderId, record.price, record.size);
+                break;
+            default:
+                // A journaled fill the replay did not reproduce
+                ++stats.mismatches;
+                continue;
+        }
+        ++stats.requests;
+    }
+    return stats;
+}
+
+const SymbolSpec& JournalReplayer::symbolSpec() const { return orderBook.symbolSpec(); }
+double JournalReplayer::getBestBid() const { return orderBook.getBestBid(); }
+double JournalReplayer::getBestAsk() const { return orderBook.getBestAsk(); }
+void JournalReplayer::printSnapshot() const { orderBook.printSnapshot(); }
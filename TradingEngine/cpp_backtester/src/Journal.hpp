@@ -0,0 +1,203 @@
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+#include "Crc32c.hpp"
+#include "OrderBook.hpp"
+#include "SymbolSpec.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+// Append-only binary journal of what a book was asked to do and what it did. Every inbound
+// request (new order, cancel, amend) is appended before the book acts on it, followed by
+// the trades it produced, as fixed 48-byte records with a sequence number and a CRC-32C.
+// Reproducing a run is then a straight scan of the file back through a fresh book, with
+// every journaled trade checked against the replayed one.
+//
+// Records are staged in a fixed buffer and written out with one write() per buffer (or on
+// flush()); the journal is ordered write-ahead with respect to the book, but not fsynced.
+// A reader stops at the first record whose CRC or sequence number is wrong, so a torn tail
+// from a crash costs only the records in it.
+
+enum class JournalRecordType : uint8_t {
+    NewOrder = 1, // orderId, isBuy, price, size
+    Cancel = 2,   // orderId
+    Amend = 3,    // orderId, price, size
+    Trade = 4,    // orderId = aggressor, restingId, isBuy = aggressor side, price, size
+};
+
+struct JournalRecord {
+    uint64_t seq;
+    uint64_t orderId;
+    uint64_t restingId;
+    Price price; // ticks
+    Qty size;    // lots
+    JournalRecordType type;
+    uint8_t isBuy;
+    uint16_t reserved;
+    uint32_t crc; // CRC-32C of the record with crc = 0
+};
+static_assert(sizeof(JournalRecord) == 48, "journal records are fixed at 48 bytes");
+
+struct JournalHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    double tickSize;
+    double lotSize;
+    char symbol[16];
+};
+static_assert(sizeof(JournalHeader) % 8 == 0, "records after the header must stay 8-byte aligned");
+
+constexpr char kJournalMagic[8] = {'T', 'E', 'J', 'O', 'U', 'R', 'N', 'L'};
+constexpr uint32_t kJournalVersion = 1;
+
+class JournalWriter {
+public:
+    JournalWriter(const std::string& path, const SymbolSpec& spec, size_t bufferRecords = 4096);
+    ~JournalWriter();
+
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    // False if the file could not be created or a write has failed
+    bool ok() const { return fd >= 0; }
+    uint64_t lastSequence() const { return lastSeq; }
+
+    // Stamps seq and CRC and stages the record; writes the buffer out once it is full
+    void append(JournalRecord record) {
+        record.seq = ++lastSeq;
+        record.reserved = 0;
+        record.crc = 0;
+        record.crc = crc32c(&record, sizeof(record));
+        buffer[staged++] = record;
+        if (staged == buffer.size()) flush();
+    }
+
+    // Writes out everything staged so far
+    bool flush();
+
+private:
+    int fd = -1;
+    std::vector<JournalRecord> buffer;
+    size_t staged = 0;
+    uint64_t lastSeq = 0;
+};
+
+// Read-only view of a journal file (mmapped). open() validates the header and every
+// record's CRC and sequence number; records() is the intact prefix.
+class JournalReader {
+public:
+    JournalReader() = default;
+    ~JournalReader();
+
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+
+    bool open(const std::string& path);
+
+    const SymbolSpec& symbolSpec() const { return spec; }
+    std::span<const JournalRecord> records() const { return valid; }
+    // True if the file ended in a torn or corrupt record that was dropped
+    bool truncated() const { return torn; }
+
+private:
+    void* mapping = nullptr;
+    size_t length = 0;
+    SymbolSpec spec;
+    std::span<const JournalRecord> valid;
+    bool torn = false;
+};
+
+// Book listener that journals each fill as it happens
+struct JournalTradeListener {
+    JournalWriter* journal;
+
+    void onTrade(const Trade& trade) {
+        journal->append(JournalRecord{0, trade.aggressorId, trade.restingId, trade.price, trade.size,
+                                      JournalRecordType::Trade, trade.aggressorIsBuy, 0, 0});
+    }
+    void onAdd(uint64_t, bool, Price, Qty) {}
+    void onCancel(uint64_t, bool, Price, Qty) {}
+    void onLevelChange(bool, Price, Qty) {}
+};
+
+// An order book with journaling switched on: each request is journaled, then applied.
+class JournaledOrderBook {
+public:
+    JournaledOrderBook(const SymbolSpec& spec, const std::string& journalPath, size_t orderCapacity = 1 << 16)
+        : journal(journalPath, spec), orderBook(spec, orderCapacity, JournalTradeListener{&journal}) {}
+
+    bool ok() const { return journal.ok(); }
+
+    uint64_t processOrderTicks(bool isBuy, Price price, Qty size) {
+        journal.append(JournalRecord{0, orderBook.upcomingOrderId(), 0, price, size, JournalRecordType::NewOrder,
+                                     isBuy, 0, 0});
+        return orderBook.processOrderTicks(isBuy, price, size);
+    }
+
+    bool cancelOrder(uint64_t orderId) {
+        journal.append(JournalRecord{0, orderId, 0, 0, 0, JournalRecordType::Cancel, 0, 0, 0});
+        return orderBook.cancelOrder(orderId);
+    }
+
+    bool amendOrderTicks(uint64_t orderId, Price newPrice, Qty newSize) {
+        journal.append(JournalRecord{0, orderId, 0, newPrice, newSize, JournalRecordType::Amend, 0, 0, 0});
+        return orderBook.amendOrderTicks(orderId, newPrice, newSize);
+    }
+
+    bool flush() { return journal.flush(); }
+
+    const BasicOrderBook<JournalTradeListener>& book() const { return orderBook; }
+    const JournalWriter& writer() const { return journal; }
+
+private:
+    JournalWriter journal;
+    BasicOrderBook<JournalTradeListener> orderBook;
+};
+
+struct JournalReplayStats {
+    uint64_t requests = 0;        // new orders, cancels and amends applied
+    uint64_t tradesMatched = 0;   // replayed fills identical to the journaled ones
+    uint64_t mismatches = 0;      // fills or order ids that differ from the journal
+    bool truncated = false;       // the journal ended in a dropped torn record
+};
+
+// Rebuilds a book from a journal and checks the replay is deterministic: each fill the
+// book produces must equal the next journaled Trade record, and each new order must get
+// the id it was journaled with.
+class JournalReplayer {
+public:
+    explicit JournalReplayer(const JournalReader& reader, size_t orderCapacity = 1 << 16);
+
+    JournalReplayStats run();
+
+    const SymbolSpec& symbolSpec() const;
+    double getBestBid() const;
+    double getBestAsk() const;
+    void printSnapshot() const;
+
+private:
+    // Compares fills against the journal in place, advancing a cursor over Trade records
+    struct CheckListener {
+        JournalReplayer* replayer;
+
+        void onTrade(const Trade& trade) { replayer->checkTrade(trade); }
+        void onAdd(uint64_t, bool, Price, Qty) {}
+        void onCancel(uint64_t, bool, Price, Qty) {}
+        void onLevelChange(bool, Price, Qty) {}
+    };
+
+    std::span<const JournalRecord> records;
+    bool truncated;
+    size_t cursor = 0;
+    JournalReplayStats stats;
+    BasicOrderBook<CheckListener> orderBook;
+
+    void checkTrade(const Trade& trade);
+};
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef LEVELBITMAP_HPP
+#define LEVELBITMAP_HPP
+
+#include "Checkpoint.hpp"
+#include <vector>
+#include <memory_resource>
+#include <cstdint>
+#include <cstddef>
+
+// Three-level occupancy bitset over a PriceLadder's slots. Bit i of level 0 marks slot i
+// as non-empty; each higher level has one bit per non-zero word of the level below.
+// Finding the next occupied slot in either direction is at most one masked word per level
+// plus a ctz/clz each, so a best-price advance costs a handful of instructions even across
+// a gap of hundreds of thousands of empty ticks (level 2 covers 2^18 slots per word).
+class LevelBitmap {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    explicit LevelBitmap(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : l0(memory), l1(memory), l2(memory) {}
+
+    // Resizes to `bits` slots and clears everything
+    void reset(size_t bits) {
+        size = bits;
+        l0.assign((bits + 63) >> 6, 0);
+        l1.assign((l0.size() + 63) >> 6, 0);
+        l2.assign((l1.size() + 63) >> 6, 0);
+    }
+
+    void save(checkpoint::Writer& out) const {
+        out.pod(static_cast<uint64_t>(size));
+        out.array(l0);
+        out.array(l1);
+        out.array(l2);
+    }
+
+    bool load(checkpoint::Reader& in) {
+        uint64_t bits = 0;
+        if (!in.pod(bits) || !in.array(l0) || !in.array(l1) || !in.array(l2)) return false;
+        if (l0.size() != (bits + 63) >> 6 || l1.size() != (l0.size() + 63) >> 6 ||
+            l2.size() != (l1.size() + 63) >> 6 || ((bits & 63) != 0 && (l0.back() >> (bits & 63)) != 0)) {
+            return in.fail();
+        }
+        // The summary levels must say exactly which words below them are non-zero, or the
+        // scans would skip live slots or stop on empty words
+        if (!summarizes(l1, l0) || !summarizes(l2, l1)) return in.fail();
+        size = static_cast<size_t>(bits);
+        return true;
+    }
+
+    size_t bitCount() const { return size; }
+
+    bool test(size_t i) const { return (l0[i >> 6] >> (i & 63)) & 1; }
+
+    void set(size_t i) {
+        l0[i >> 6] |= bit(i);
+        l1[i >> 12] |= bit(i >> 6);
+        l2[i >> 18] |= bit(i >> 12);
+    }
+
+    void clear(size_t i) {
+        if ((l0[i >> 6] &= ~bit(i)) != 0) return;
+        if ((l1[i >> 12] &= ~bit(i >> 6)) != 0) return;
+        l2[i >> 18] &= ~bit(i >> 12);
+    }
+
+    // Lowest occupied slot >= i, or npos
+    size_t findNext(size_t i) const {
+        if (i >= size) return npos;
+        size_t w0 = i >> 6;
+        uint64_t m = l0[w0] & (~0ull << (i & 63));
+        if (m) return (w0 << 6) | __builtin_ctzll(m);
+
+        size_t j = w0 + 1;
+        if (j >= l0.size()) return npos;
+        size_t w1 = j >> 6;
+        m = l1[w1] & (~0ull << (j & 63));
+        if (m) return descendLow(w1, m);
+
+        size_t k = w1 + 1;
+        if (k >= l1.size()) return npos;
+        size_t w2 = k >> 6;
+        m = l2[w2] & (~0ull << (k & 63));
+        while (!m) {
+            if (++w2 >= l2.size()) return npos;
+            m = l2[w2];
+        }
+        w1 = (w2 << 6) | __builtin_ctzll(m);
+        return descendLow(w1, l1[w1]);
+    }
+
+    // Highest occupied slot <= i, or npos
+    size_t findPrev(size_t i) const {
+        if (i == npos) return npos;
+        if (i >= size) i = size - 1;
+        size_t w0 = i >> 6;
+        uint64_t m = l0[w0] & (~0ull >> (63 - (i & 63)));
+        if (m) return (w0 << 6) | (63 - __builtin_clzll(m));
+
+        if (w0 == 0) return npos;
+        size_t j = w0 - 1;
+        size_t w1 = j >> 6;
+        m = l1[w1] & (~0ull >> (63 - (j & 63)));
+        if (m) return descendHigh(w1, m);
+
+        if (w1 == 0) return npos;
+        size_t k = w1 - 1;
+        size_t w2 = k >> 6;
+        m = l2[w2] & (~0ull >> (63 - (k & 63)));
+        while (!m) {
+            if (w2-- == 0) return npos;
+            m = l2[w2];
+        }
+        w1 = (w2 << 6) | (63 - __builtin_clzll(m));
+        return descendHigh(w1, l1[w1]);
+    }
+
+private:
+    size_t size = 0;
+    std::pmr::vector<uint64_t> l0, l1, l2;
+
+    static uint64_t bit(size_t i) { return 1ull << (i & 63); }
+
+    // True if bit w of `upper` is set exactly when lower[w] is non-zero
+    static bool summarizes(const std::pmr::vector<uint64_t>& upper, const std::pmr::vector<uint64_t>& lower) {
+        for (size_t w = 0; w < upper.size() * 64; ++w) {
+            bool set = (upper[w >> 6] & bit(w)) != 0;
+            if (set != (w < lower.size() && lower[w] != 0)) return false;
+        }
+        return true;
+    }
+
+    // Given a non-zero mask of level-1 word w1, resolve to the lowest/highest occupied slot
+    size_t descendLow(size_t w1, uint64_t m1) const {
+        size_t w0 = (w1 << 6) | __builtin_ctzll(m1);
+        return (w0 << 6) | __builtin_ctzll(l0[w0]);
+    }
+    size_t descendHigh(size_t w1, uint64_t m1) const {
+        size_t w0 = (w1 << 6) | (63 - __builtin_clzll(m1));
+        return (w0 << 6) | (63 - __builtin_clzll(l0[w0]));
+    }
+};
+
+#endif
@@ -0,0 +1,38 @@
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::~MappedFile() {
+    if (mapping) munmap(mapping, length);
+}
+
+bool MappedFile::open(const std::string& path, Access access) {
+    if (mapping) {
+        munmap(mapping, length);
+        mapping = nullptr;
+        length = 0;
+    }
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+    // The access pattern and the prefetch are separate advice values, not flags, so each
+    // needs its own call. Either way the whole file is about to be read, so start on it now.
+    madvise(mapped, static_cast<size_t>(st.st_size), access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    madvise(mapped, static_cast<size_t>(st.st_size), MADV_WILLNEED);
+    mapping = mapped;
+    length = static_cast<size_t>(st.st_size);
+    return true;
+}
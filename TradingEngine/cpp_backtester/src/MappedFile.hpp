@@ -0,0 +1,35 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only memory map of a whole file
+class MappedFile {
+public:
+    // How the caller will read the mapping, passed on to the kernel as readahead advice
+    enum class Access {
+        Sequential, // one pass front to back (CSV parsing)
+        Random,     // jumps straight to the parts it needs (column cache)
+    };
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Returns false if the file can't be opened or mapped (an empty file maps as empty)
+    bool open(const std::string& path, Access access);
+
+    const char* data() const { return static_cast<const char*>(mapping); }
+    size_t size() const { return length; }
+    std::string_view text() const { return std::string_view(data(), length); }
+
+private:
+    void* mapping = nullptr;
+    size_t length = 0;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "MatchingLoop.hpp"
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+MatchingLoop::MatchingLoop(size_t ringCapacity) : ring(ringCapacity) {}
+
+MatchingLoop::~MatchingLoop() {
+    stop();
+}
+
+uint32_t MatchingLoop::addBook(const SymbolSpec& spec, size_t orderCapacity) {
+    books.push_back(std::make_unique<OrderBook>(spec, orderCapacity));
+    return static_cast<uint32_t>(books.size() - 1);
+}
+
+void MatchingLoop::start(int core) {
+    if (worker.joinable()) return;
+    stopping.store(false, std::memory_order_relaxed);
+    worker = std::thread(&MatchingLoop::run, this, core);
+}
+
+void MatchingLoop::stop() {
+    if (!worker.joinable()) return;
+    drain();
+    stopping.store(true, std::memory_order_release);
+    worker.join();
+}
+
+void MatchingLoop::drain() {
+    publish();
+    if (!worker.joinable()) return;
+    int spins = 0;
+    while (processed.load(std::memory_order_acquire) != submitted) {
+        SpscRing<RoutedOrder>::backoff(spins);
+    }
+}
+
+void MatchingLoop::run(int core) {
+#ifdef __linux__
+    if (core >= 0) {
+        // Pin the loop so its books stay hot in one core's caches
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(core, &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+#else
+    (void)core;
+#endif
+
+    uint64_t done = 0; // only this thread advances `processed`
+    int idleSpins = 0;
+    while (true) {
+        size_t consumed = ring.consume([&](std::span<const RoutedOrder> block) {
+            for (const RoutedOrder& routed : block) {
+                const OrderRequest& req = routed.order;
+                books[routed.book]->processOrderTicks(req.isBuy, req.price, req.size);
+            }
+        });
+
+        if (consumed > 0) {
+            done += consumed;
+            processed.store(done, std::memory_order_release);
+            idleSpins = 0;
+            continue;
+        }
+
+        // Ring is empty: exit if asked to (stop() drains first), otherwise poll again
+        if (stopping.load(std::memory_order_acquire)) return;
+        SpscRing<RoutedOrder>::backoff(idleSpins);
+    }
+}
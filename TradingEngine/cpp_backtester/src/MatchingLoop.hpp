@@ -0,0 +1,75 @@
+#ifndef MATCHINGLOOP_HPP
+#define MATCHINGLOOP_HPP
+
+#include "OrderBook.hpp"
+#include "SpscRing.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// An order addressed to one of the loop's books
+struct RoutedOrder {
+    uint32_t book;
+    OrderRequest order;
+};
+
+// A dedicated matching thread fed through an SpscRing. One producer (a parser, gateway or
+// router thread) submits orders while the loop drains the ring into its books, so parsing
+// and matching overlap instead of running back to back in one thread. The loop is the only
+// thread that touches its books once started.
+//
+// Usage: addBook() while stopped, start(), submit()/publish() from one producer thread,
+// drain() to wait until everything submitted has been matched. Books may be read by other
+// threads only after drain() or stop(), while nothing more is being submitted.
+class MatchingLoop {
+public:
+    explicit MatchingLoop(size_t ringCapacity = 1 << 16);
+    ~MatchingLoop();
+
+    MatchingLoop(const MatchingLoop&) = delete;
+    MatchingLoop& operator=(const MatchingLoop&) = delete;
+
+    uint32_t addBook(const SymbolSpec& spec, size_t orderCapacity = 1 << 16);
+    OrderBook& book(uint32_t index) { return *books[index]; }
+    const OrderBook& book(uint32_t index) const { return *books[index]; }
+    size_t bookCount() const { return books.size(); }
+
+    // Starts the matching thread, pinned to `core` if it is non-negative (Linux only)
+    void start(int core = -1);
+    void stop();
+
+    // Producer side. Orders are staged in the ring and published in blocks of
+    // kPublishBlock, or explicitly via publish()/drain().
+    void submit(uint32_t book, const OrderRequest& order) {
+        ring.write(RoutedOrder{book, order});
+        if (++submitted - lastPublished >= kPublishBlock) publish();
+    }
+
+    void publish() {
+        ring.publish();
+        lastPublished = submitted;
+    }
+
+    // Publishes everything staged and waits until the loop has matched it
+    void drain();
+
+private:
+    static constexpr uint64_t kPublishBlock = 64;
+
+    SpscRing<RoutedOrder> ring;
+    std::vector<std::unique_ptr<OrderBook>> books;
+
+    // Producer-owned counters
+    uint64_t submitted = 0;
+    uint64_t lastPublished = 0;
+
+    std::atomic<uint64_t> processed{0};
+    std::atomic<bool> stopping{false};
+    std::thread worker;
+
+    void run(int core);
+};
+
+#endif
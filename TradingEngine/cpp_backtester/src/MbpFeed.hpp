@@ -0,0 +1,72 @@
+#ifndef MBPFEED_HPP
+#define MBPFEED_HPP
+
+#include "BookEvents.hpp"
+#include "SpscRing.hpp"
+#include "SymbolSpec.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+// One market-by-price delta: the new aggregate size at a price (0 = level removed)
+struct MbpUpdate {
+    uint64_t seq;  // 1, 2, 3, ... per feed
+    Price price;   // ticks
+    Qty totalSize; // lots
+    bool isBid;
+};
+
+// Market-by-price delta stream for one book. The book's level-change events are stamped
+// with a sequence number and staged in a preallocated SpscRing, so a consumer (in-thread or
+// on another core) keeps its own price -> size map current from a few bytes per change
+// instead of re-reading full snapshots.
+//
+// The producer never blocks: if the consumer falls a full ring behind, updates are dropped
+// and counted, but seq still advances. A consumer that sees a gap in seq discards its copy
+// and, once the producer is quiescent, rebuilds it from OrderBook::forEachLevel (every
+// level, not just the top-N depth views) and carries on from lastSequence() + 1. Updates
+// still in the ring with a seq at or below that are already in the rebuilt copy.
+class MbpFeed {
+public:
+    explicit MbpFeed(size_t capacity = 1 << 16) : ring(capacity) {}
+
+    // ─── Producer side (the matching thread) ─────────────────────────
+
+    void push(bool isBid, Price price, Qty totalSize) {
+        if (!ring.tryWrite(MbpUpdate{++lastSeq, price, totalSize, isBid})) ++droppedCount;
+    }
+
+    // Makes everything pushed so far visible to the consumer. Call once per processed
+    // order or batch rather than per update.
+    void publish() { ring.publish(); }
+
+    uint64_t lastSequence() const { return lastSeq; }
+    uint64_t dropped() const { return droppedCount; }
+
+    // ─── Consumer side ───────────────────────────────────────────────
+
+    // Hands published updates to fn in contiguous blocks; returns how many were consumed
+    template <typename Fn>
+    size_t consume(Fn&& fn, size_t maxItems = SIZE_MAX) {
+        return ring.consume(std::forward<Fn>(fn), maxItems);
+    }
+
+private:
+    SpscRing<MbpUpdate> ring;
+    uint64_t lastSeq = 0;
+    uint64_t droppedCount = 0;
+};
+
+// Book listener that forwards level changes to an MbpFeed. Use as
+// BasicOrderBook<MbpFeedListener> book(spec, capacity, MbpFeedListener{&feed});
+struct MbpFeedListener {
+    MbpFeed* feed;
+
+    void onTrade(const Trade&) {}
+    void onAdd(uint64_t, bool, Price, Qty) {}
+    void onCancel(uint64_t, bool, Price, Qty) {}
+    void onLevelChange(bool isBid, Price price, Qty newTotalSize) { feed->push(isBid, price, newTotalSize); }
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "MonteCarlo.hpp"
+#include "CandleBacktest.hpp"
+#include "CounterRng.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+// Resamples are handed to workers this many at a time; each one is only a few thousand
+// additions, too little to fetch from the shared counter individually
+constexpr size_t kSamplesPerJob = 64;
+
+// Running Sharpe sums and drawdown of an equity curve that starts at 0, with drawdown
+// measured after every trade as CandleBacktest does
+struct PathStats {
+    double sum = 0;
+    double sq_sum = 0;
+    double peak = 0;
+    double maxDrawdown = 0;
+
+    void add(double r) {
+        sum += r;
+        sq_sum += r * r;
+        if (sum > peak) peak = sum;
+        if (peak - sum > maxDrawdown) maxDrawdown = peak - sum;
+    }
+};
+
+// Linearly interpolated percentile of sorted values, q in [0, 1]
+double percentile(const std::vector<double>& sorted, double q) {
+    double rank = q * static_cast<double>(sorted.size() - 1);
+    size_t below = static_cast<size_t>(rank);
+    if (below + 1 >= sorted.size()) return sorted.back();
+    double weight = rank - static_cast<double>(below);
+    return sorted[below] + (sorted[below + 1] - sorted[below]) * weight;
+}
+
+// Summarizes the values in sample order, so the mean doesn't depend on who computed what
+Distribution summarize(std::vector<double>& values) {
+    Distribution d;
+    double sum = 0, sq_sum = 0;
+    for (double v : values) sum += v;
+    d.mean = sum / values.size();
+    for (double v : values) sq_sum += (v - d.mean) * (v - d.mean);
+    d.stdDev = std::sqrt(sq_sum / values.size());
+    std::sort(values.begin(), values.end());
+    d.p5 = percentile(values, 0.05);
+    d.p50 = percentile(values, 0.50);
+    d.p95 = percentile(values, 0.95);
+    return d;
+}
+
+void writeDistribution(std::ofstream& out, const char* name, const Distribution& d, bool last) {
+    out << "  \"" << name << "\": {\"mean\": " << d.mean << ", \"std_dev\": " << d.stdDev << ", \"p5\": " << d.p5
+        << ", \"p50\": " << d.p50 << ", \"p95\": " << d.p95 << "}" << (last ? "\n" : ",\n");
+}
+
+} // namespace
+
+bool bootstrapReturns(std::span<const double> returns, const MonteCarloSpec& spec, MonteCarloReport& report,
+                      std::string& error) {
+    report = MonteCarloReport{};
+    const size_t n = returns.size();
+    if (n < 2) {
+        error = "need at least two trades to resample";
+        return false;
+    }
+    if (spec.samples == 0) {
+        error = "samples must be at least one";
+        return false;
+    }
+    size_t block = spec.blockLength;
+    if (block == 0) block = static_cast<size_t>(std::lround(std::cbrt(static_cast<double>(n))));
+    block = std::clamp<size_t>(block, 1, n);
+
+    report.trades = n;
+    report.samples = spec.samples;
+    report.blockLength = block;
+    report.seed = spec.seed;
+
+    PathStats observed;
+    for (double r : returns) observed.add(r);
+    report.observedSharpe = sharpeFromSums(observed.sum, observed.sq_sum, n);
+    report.observedPnL = observed.sum;
+    report.observedMaxDrawdown = observed.maxDrawdown;
+
+    std::vector<double> sharpe(spec.samples), pnl(spec.samples), drawdown(spec.samples);
+    const size_t jobs = (spec.samples + kSamplesPerJob - 1) / kSamplesPerJob;
+    parallelFor(jobs, spec.threads, [&](size_t job) {
+        const size_t end = std::min(spec.samples, (job + 1) * kSamplesPerJob);
+        for (size_t s = job * kSamplesPerJob; s < end; ++s) {
+            CounterRng rng(spec.seed, s);
+            PathStats path;
+            for (size_t drawn = 0; drawn < n;) {
+                // One block: up to `block` trades from a random start, wrapping at the end
+                size_t at = static_cast<size_t>(rng.below(n));
+                for (size_t k = 0; k < block && drawn < n; ++k, ++drawn) {
+                    path.add(returns[at]);
+                    if (++at == n) at = 0;
+                }
+            }
+            sharpe[s] = sharpeFromSums(path.sum, path.sq_sum, n);
+            pnl[s] = path.sum;
+            drawdown[s] = path.maxDrawdown;
+        }
+    });
+
+    report.lossProbability =
+        static_cast<double>(std::count_if(pnl.begin(), pnl.end(), [](double v) { return v < 0; })) / spec.samples;
+    report.sharpe = summarize(sharpe);
+    report.totalPnL = summarize(pnl);
+    report.maxDrawdown = summarize(drawdown);
+    return true;
+}
+
+bool MonteCarloReport::writeJson(const std::string& path, const std::string& strategy) const {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+    out << "{\n";
+    out << "  \"strategy\": \"" << strategy << "\",\n";
+    out << "  \"trades\": " << trades << ",\n";
+    out << "  \"samples\": " << samples << ",\n";
+    out << "  \"block_length\": " << blockLength << ",\n";
+    out << "  \"seed\": " << seed << ",\n";
+    out << "  \"observed_sharpe\": " << observedSharpe << ",\n";
+    out << "  \"observed_pnl\": " << observedPnL << ",\n";
+    out << "  \"observed_max_drawdown\": " << observedMaxDrawdown << ",\n";
+    out << "  \"loss_probability\": " << lossProbability << ",\n";
+    writeDistribution(out, "sharpe_ratio", sharpe, false);
+    writeDistribution(out, "total_pnl", totalPnL, false);
+    writeDistribution(out, "max_drawdown", maxDrawdown, true);
+    out << "}\n";
+    return static_cast<bool>(out);
+}
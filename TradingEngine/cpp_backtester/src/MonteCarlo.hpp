@@ -0,0 +1,55 @@
+#ifndef MONTECARLO_HPP
+#define MONTECARLO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+// Monte Carlo bootstrap of a backtest's per-trade returns, to put error bars on a single
+// Sharpe ratio and drawdown. Each resample is a new sequence of as many trades as the
+// original, built from blocks of consecutive trades starting at random points (a circular
+// block bootstrap), so runs of wins and losses survive the reshuffle; its Sharpe ratio,
+// total PnL and max drawdown are then summarized over all resamples.
+//
+// Resample s draws only from CounterRng stream (seed, s), so its trades, and therefore the
+// whole report, depend on the seed alone and not on how many threads did the work.
+
+struct MonteCarloSpec {
+    size_t samples = 10000;
+    size_t blockLength = 0; // trades per block; 0 = cube root of the trade count
+    uint64_t seed = 42;
+    unsigned threads = 0; // 0 = one per hardware thread
+};
+
+// One metric over all resamples
+struct Distribution {
+    double mean = 0;
+    double stdDev = 0;
+    double p5 = 0;
+    double p50 = 0;
+    double p95 = 0;
+};
+
+struct MonteCarloReport {
+    size_t trades = 0;
+    size_t samples = 0;
+    size_t blockLength = 0;
+    uint64_t seed = 0;
+    // The original trade order, measured the same way as the resamples
+    double observedSharpe = 0;
+    double observedPnL = 0;
+    double observedMaxDrawdown = 0;
+    Distribution sharpe;
+    Distribution totalPnL;
+    Distribution maxDrawdown;
+    double lossProbability = 0; // share of resamples that end below zero
+
+    bool writeJson(const std::string& path, const std::string& strategy) const;
+};
+
+// Fails (with `error` set) on fewer than two returns or zero samples
+bool bootstrapReturns(std::span<const double> returns, const MonteCarloSpec& spec, MonteCarloReport& report,
+                      std::string& error);
+
+#endif
@@ -1,54 +1,486 @@
 #ifndef ORDERBOOK_HPP
 #define ORDERBOOK_HPP
 
+#include "BookTypes.hpp"
+#include "BookEvents.hpp"
+#include "SymbolSpec.hpp"
+#include "PriceLadder.hpp"
+#include "OrderPool.hpp"
+#include "OrderIdIndex.hpp"
+#include "DepthCache.hpp"
+#include "Checkpoint.hpp"
+#include <algorithm>
+#include <span>
 #include <vector>
+#include <memory_resource>
 #include <string>
+#include <utility>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iomanip> // For setprecision
 
-// Cache-line aligned Order structure (64 bytes)
-struct alignas(64) Order {
-    uint64_t orderId;
-    double price;
-    double size;
-    bool isBuy;
-    // Padding to ensure the struct fills a 64-byte cache line (optional depending on architecture,
-    // but demonstrating knowledge of cache coherence for high-frequency trading)
-    char padding[39];
-};
-
-// Represents a price level in the flat-array orderbook
-struct PriceLevel {
-    double price;
-    double totalSize;
-    std::vector<Order> orders; // In a true ULF system we'd use a custom allocator or fixed array
-
-    PriceLevel(double p) : price(p), totalSize(0) {}
-};
-
-class OrderBook {
+// The book is a template over its event-listener policy (see BookEvents.hpp) so that
+// trade and book-change reporting is resolved at compile time. The default OrderBook
+// uses NullBookListener and pays nothing for it.
+template <typename Listener = NullBookListener>
+class BasicOrderBook {
 private:
-    std::string symbol;
+    SymbolSpec spec;
     
     // Instead of std::map or std::set which are node-based and cause cache misses,
-    // we use contiguous memory via std::vector.
-    std::vector<PriceLevel> bids;
-    std::vector<PriceLevel> asks;
+    // each side is a tick-indexed ladder over contiguous memory. Level lookup is an
+    // index computation and the best price is tracked directly, so there is no sorting.
+    PriceLadder bids;
+    PriceLadder asks;
+
+    // Every resting order lives in this slab; levels chain their FIFO queues' blocks through it
+    OrderPool orders;
+    OrderIdIndex orderIndex;
 
     uint64_t nextOrderId = 1;
 
+public:
+    // Number of levels per side kept in the incremental L2 depth view
+    static constexpr size_t kDepthLevels = 10;
+
+private:
+    DepthCache<kDepthLevels> bidDepthCache;
+    DepthCache<kDepthLevels> askDepthCache;
+
+    // Reused output buffer for processBatch
+    std::pmr::vector<OrderResult> batchResults;
+
+    [[no_unique_address]] Listener listener;
+
+    // How many orders ahead processBatch prefetches target levels
+    static constexpr size_t kPrefetchDistance = 4;
+
+    Qty submitOrder(uint64_t orderId, bool isBuy, Price price, Qty size);
+    void levelChanged(bool isBid, Price price, Qty newTotalSize);
+    void removeOrder(NodeId id);
     void matchOrder(Order& incoming);
-    void insertOrderIntoBook(const Order& order, std::vector<PriceLevel>& book, bool isBid);
+    void insertOrderIntoBook(const Order& order, PriceLadder& book);
+    static bool restoredLinksInRange(const PriceLadder& bids, const PriceLadder& asks, const OrderPool& orders,
+                                     const OrderIdIndex& index);
 
 public:
-    OrderBook(const std::string& sym);
+    // All of the book's storage (ladders, order slab, id index) is drawn from `memory`. Passing
+    // an arena such as std::pmr::monotonic_buffer_resource lets a caller that builds and drops
+    // many books reset one buffer between them instead of freeing and re-mallocing each array;
+    // the arena must outlive the book.
+    BasicOrderBook(const SymbolSpec& spec, size_t orderCapacity = 1 << 16, Listener listener = Listener(),
+                   std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+    BasicOrderBook(const std::string& sym, size_t orderCapacity = 1 << 16, Listener listener = Listener(),
+                   std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    const SymbolSpec& symbolSpec() const { return spec; }
+    // The id the next new order will be assigned (ids are sequential from 1)
+    uint64_t upcomingOrderId() const { return nextOrderId; }
+    Listener& eventListener() { return listener; }
+    const Listener& eventListener() const { return listener; }
+
+    // Matches the order and rests any remainder. Returns the assigned order id.
+    // The double overloads convert at the boundary; the Ticks variants take fixed-point
+    // values directly for callers that pre-convert (e.g. a parsed tape).
+    uint64_t processOrder(bool isBuy, double price, double size);
+    uint64_t processOrderTicks(bool isBuy, Price price, Qty size);
+
+    // Replays a run of pre-converted orders in one call, prefetching the levels the next
+    // few orders will land on while the current one matches. The returned view (one
+    // result per request, in order) stays valid until the next processBatch call.
+    std::span<const OrderResult> processBatch(std::span<const OrderRequest> requests);
+
+    // Removes a resting order. Returns false if it is unknown or already filled.
+    bool cancelOrder(uint64_t orderId);
 
-    void processOrder(bool isBuy, double price, double size);
+    // Changes a resting order's price and/or size. Reducing size at the same price keeps
+    // time priority; any other change is a cancel-replace that may match immediately.
+    // A new size of zero or less cancels the order.
+    bool amendOrder(uint64_t orderId, double newPrice, double newSize);
+    bool amendOrderTicks(uint64_t orderId, Price newPrice, Qty newSize);
     
+    // Best prices straight off the ladders, in ticks (PriceLadder::kNoTick if that side is empty)
+    Price bestBidTicks() const { return bids.bestTick(); }
+    Price bestAskTicks() const { return asks.bestTick(); }
+
+    // Top kDepthLevels levels per side (ticks/lots), best first. Maintained incrementally by
+    // every match/insert/cancel; the span views the book's own cache and is valid until the
+    // book is next modified.
+    std::span<const DepthLevel> bidDepth() const { return bidDepthCache.view(); }
+    std::span<const DepthLevel> askDepth() const { return askDepthCache.view(); }
+
+    // Every level of one side, best first, as fn(price, totalSize) in ticks/lots until fn
+    // returns false. Unlike the depth views this reaches the whole book, overflow included,
+    // so it is what a market-by-price consumer rebuilds from after a gap (see MbpFeed).
+    template <typename Fn>
+    void forEachLevel(bool isBid, Fn&& fn) const {
+        (isBid ? bids : asks).forEachLevel([&](const PriceLevel& level) { return fn(level.price, level.totalSize); });
+    }
+
+    // Empties the book and restarts order ids at 1 while keeping every allocation (ladder
+    // windows, order slab, id table), so a book can be reused across repeated runs without
+    // rebuilding it. The listener is left as it is.
+    void reset();
+
+    // Writes the full book state (resting orders, queues, id index, next order id) to a
+    // flat binary checkpoint (see Checkpoint.hpp). Returns false on I/O failure.
+    bool saveCheckpoint(const std::string& path) const;
+
+    // Replaces this book's state with a checkpoint written by saveCheckpoint for the same
+    // symbol. On any failure (missing file, other version or layout, other symbol, bad
+    // checksum, links out of range) returns false and leaves the book untouched.
+    // The listener is not replayed the restored orders.
+    bool loadCheckpoint(const std::string& path);
+
     // Utilities for backtesting insights
     double getBestBid() const;
     double getBestAsk() const;
     void printSnapshot() const;
 };
 
+using OrderBook = BasicOrderBook<>;
+
+// ─── Implementation ─────────────────────────────────────────────────────
+// Defined in the header so custom listeners are inlined into the matching loop.
+// The default OrderBook is explicitly instantiated once in OrderBook.cpp.
+
+template <typename Listener>
+BasicOrderBook<Listener>::BasicOrderBook(const SymbolSpec& spec, size_t orderCapacity, Listener listener,
+                                         std::pmr::memory_resource* memory)
+    : spec(spec), bids(true, PriceLadder::kInitialLevels, memory),
+      asks(false, PriceLadder::kInitialLevels, memory), orders(orderCapacity, memory),
+      orderIndex(orderCapacity, memory), bidDepthCache(true), askDepthCache(false), batchResults(memory),
+      listener(std::move(listener)) {}
+
+template <typename Listener>
+BasicOrderBook<Listener>::BasicOrderBook(const std::string& sym, size_t orderCapacity, Listener listener,
+                                         std::pmr::memory_resource* memory)
+    : BasicOrderBook(symbolSpecFor(sym), orderCapacity, std::move(listener), memory) {}
+
+template <typename Listener>
+uint64_t BasicOrderBook<Listener>::processOrder(bool isBuy, double price, double size) {
+    return processOrderTicks(isBuy, spec.toTicks(price), spec.toLots(size));
+}
+
+template <typename Listener>
+uint64_t BasicOrderBook<Listener>::processOrderTicks(bool isBuy, Price price, Qty size) {
+    uint64_t orderId = nextOrderId++;
+    submitOrder(orderId, isBuy, price, size);
+    return orderId;
+}
+
+template <typename Listener>
+std::span<const OrderResult> BasicOrderBook<Listener>::processBatch(std::span<const OrderRequest> requests) {
+    batchResults.resize(requests.size());
+    const size_t n = requests.size();
+
+    // Ids are assigned sequentially, so both the level an order will rest on and its id
+    // index slot are known ahead of time. Warm the first window before the loop starts.
+    for (size_t i = 0; i < std::min(n, kPrefetchDistance); ++i) {
+        (requests[i].isBuy ? bids : asks).prefetchLevel(requests[i].price);
+        orderIndex.prefetch(nextOrderId + i);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (i + kPrefetchDistance < n) {
+            const OrderRequest& ahead = requests[i + kPrefetchDistance];
+            (ahead.isBuy ? bids : asks).prefetchLevel(ahead.price);
+            orderIndex.prefetch(nextOrderId + kPrefetchDistance);
+        }
+        const OrderRequest& req = requests[i];
+        uint64_t orderId = nextOrderId++;
+        Qty resting = submitOrder(orderId, req.isBuy, req.price, req.size);
+        batchResults[i] = OrderResult{orderId, req.size - resting, resting};
+    }
+    return std::span<const OrderResult>(batchResults.data(), n);
+}
+
+template <typename Listener>
+Qty BasicOrderBook<Listener>::submitOrder(uint64_t orderId, bool isBuy, Price price, Qty size) {
+    Order newOrder;
+    newOrder.orderId = orderId;
+    newOrder.price = price;
+    newOrder.size = size;
+    newOrder.isBuy = isBuy;
+
+    matchOrder(newOrder);
+
+    // If order has remaining size after matching, add it to the book
+    if (newOrder.size > 0) {
+        insertOrderIntoBook(newOrder, newOrder.isBuy ? bids : asks);
+    }
+    return newOrder.size;
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::matchOrder(Order& incoming) {
+    auto& bookToMatchAgainst = incoming.isBuy ? asks : bids;
+
+    while (incoming.size > 0 && !bookToMatchAgainst.empty()) {
+        Price bestTick = bookToMatchAgainst.bestTick();
+
+        // Check if prices cross
+        if (incoming.isBuy && incoming.price < bestTick) break;
+        if (!incoming.isBuy && incoming.price > bestTick) break;
+
+        // Match against orders at this price level, front of the queue first. Filled
+        // orders leave their block as they go; an emptied block returns to the pool.
+        auto& bestLevel = bookToMatchAgainst.bestLevel();
+        incoming.size = orders.consumeFront(bestLevel, incoming.size, [&](uint64_t restingId, Qty tradeSize, bool done) {
+            listener.onTrade(Trade{incoming.orderId, restingId, bestTick, tradeSize, incoming.isBuy});
+            bestLevel.totalSize -= tradeSize;
+            if (done) orderIndex.erase(restingId);
+        });
+
+        levelChanged(!incoming.isBuy, bestTick, bestLevel.totalSize);
+
+        // If the price level is empty, the ladder advances to the next best price
+        if (bestLevel.empty()) {
+            bookToMatchAgainst.deactivate(bestTick);
+        }
+    }
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::insertOrderIntoBook(const Order& order, PriceLadder& book) {
+    // Direct index into the ladder; an empty slot simply becomes a new price level
+    PriceLevel& level = book.levelAt(order.price);
+    bool isNewLevel = level.empty();
+
+    NodeId slot = orders.pushBack(level, order.price, order.isBuy, order.orderId, order.size);
+    orderIndex.insert(order.orderId, slot);
+    level.totalSize += order.size;
+
+    if (isNewLevel) {
+        book.activate(order.price);
+    }
+
+    listener.onAdd(order.orderId, order.isBuy, order.price, order.size);
+    levelChanged(order.isBuy, order.price, level.totalSize);
+}
+
+// Every level size change funnels through here: keep the depth cache current, then tell
+// the listener. Runs before the ladder drops an emptied level so the cache can look past it.
+template <typename Listener>
+void BasicOrderBook<Listener>::levelChanged(bool isBid, Price price, Qty newTotalSize) {
+    if (isBid) bidDepthCache.apply(price, newTotalSize, bids);
+    else askDepthCache.apply(price, newTotalSize, asks);
+    listener.onLevelChange(isBid, price, newTotalSize);
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::removeOrder(NodeId slot) {
+    const uint64_t orderId = orders.orderId(slot);
+    const Qty size = orders.size(slot);
+    const bool isBuy = orders.info(slot).isBuy;
+    const Price tick = orders.info(slot).price;
+    PriceLadder& book = isBuy ? bids : asks;
+    PriceLevel& level = book.levelAt(tick);
+
+    listener.onCancel(orderId, isBuy, tick, size);
+
+    orders.remove(level, slot);
+    level.totalSize -= size;
+    orderIndex.erase(orderId);
+
+    levelChanged(isBuy, tick, level.totalSize);
+
+    if (level.empty()) {
+        book.deactivate(tick);
+    }
+}
+
+template <typename Listener>
+bool BasicOrderBook<Listener>::cancelOrder(uint64_t orderId) {
+    NodeId id = orderIndex.find(orderId);
+    if (id == kNullNode) return false;
+    removeOrder(id);
+    return true;
+}
+
+template <typename Listener>
+bool BasicOrderBook<Listener>::amendOrder(uint64_t orderId, double newPrice, double newSize) {
+    return amendOrderTicks(orderId, spec.toTicks(newPrice), spec.toLots(newSize));
+}
+
+template <typename Listener>
+bool BasicOrderBook<Listener>::amendOrderTicks(uint64_t orderId, Price newPrice, Qty newSize) {
+    NodeId slot = orderIndex.find(orderId);
+    if (slot == kNullNode) return false;
+
+    Qty& size = orders.size(slot);
+    const bool isBuy = orders.info(slot).isBuy;
+    const Price price = orders.info(slot).price;
+    if (newSize <= 0) {
+        removeOrder(slot);
+        return true;
+    }
+
+    if (newPrice == price && newSize <= size) {
+        // Size-down in place: the order keeps its position in the queue
+        PriceLevel& level = (isBuy ? bids : asks).levelAt(price);
+        Qty reduction = size - newSize;
+        level.totalSize -= reduction;
+        size = newSize;
+        if (reduction > 0) {
+            listener.onCancel(orderId, isBuy, price, reduction);
+            levelChanged(isBuy, price, level.totalSize);
+        }
+        return true;
+    }
+
+    // Price change or size-up loses priority: pull the order and resubmit it under the same id
+    removeOrder(slot);
+    submitOrder(orderId, isBuy, newPrice, newSize);
+    return true;
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::reset() {
+    bids.clear();
+    asks.clear();
+    // A book that ends a run nearly empty only has a few ids to take out of the index, which
+    // is far cheaper than wiping a table sized for the whole capacity
+    if (orders.size() * 8 < orderIndex.capacity()) {
+        orders.forEachOrder([&](uint64_t orderId) { orderIndex.erase(orderId); });
+    } else {
+        orderIndex.clear();
+    }
+    orders.clear();
+    bidDepthCache.clear();
+    askDepthCache.clear();
+    batchResults.clear();
+    nextOrderId = 1;
+}
+
+template <typename Listener>
+bool BasicOrderBook<Listener>::saveCheckpoint(const std::string& path) const {
+    checkpoint::Writer out(path);
+    if (!out.ok()) return false;
+    out.pod(checkpoint::kMagic);
+    out.pod(checkpoint::kVersion);
+    out.pod(static_cast<uint32_t>(sizeof(OrderBlock)));
+    out.pod(static_cast<uint32_t>(sizeof(OrderBlockInfo)));
+    out.pod(static_cast<uint32_t>(sizeof(PriceLevel)));
+    out.string(spec.symbol);
+    out.pod(spec.tickSize);
+    out.pod(spec.lotSize);
+    out.pod(nextOrderId);
+    bids.save(out);
+    asks.save(out);
+    orders.save(out);
+    orderIndex.save(out);
+    return out.commit();
+}
+
+// Checks that every link in a restored book stays inside its arrays: queue ends, block
+// links and id-index slots must each fall in the slab or be kNullNode, every block's slot
+// range must fit in it, and the level, block and index counts must add up to the live
+// orders. The file's checksum guarantees the links are the ones that were saved; this
+// guarantees that even a file written wrong can't send matching outside the slab. Both are
+// sequential passes -- walking every queue to prove its links agree would chase each
+// block through memory and cost as much as a replay.
+template <typename Listener>
+bool BasicOrderBook<Listener>::restoredLinksInRange(const PriceLadder& bids, const PriceLadder& asks,
+                                                    const OrderPool& orders, const OrderIdIndex& index) {
+    const size_t blocks = orders.blockCount();
+    auto inRange = [blocks](NodeId id) { return id == kNullNode || id < blocks; };
+
+    size_t queued = 0;
+    bool ok = true;
+    for (const PriceLadder* side : {&bids, &asks}) {
+        side->forEachLevel([&](const PriceLevel& level) {
+            queued += level.orderCount;
+            return ok = level.head != kNullNode && level.tail != kNullNode && inRange(level.head) &&
+                        inRange(level.tail) && level.totalSize > 0;
+        });
+        if (!ok) return false;
+    }
+    if (queued != orders.size() || index.size() != queued || !inRange(orders.freeListHead())) return false;
+
+    for (NodeId id = 0; id < blocks; ++id) {
+        const OrderBlockInfo& info = orders.blockInfo(id);
+        if (!inRange(info.prev) || !inRange(info.next) || info.begin > info.end || info.end > kBlockOrders ||
+            info.live > info.end - info.begin) {
+            return false;
+        }
+    }
+    index.forEach([&](uint64_t, NodeId slot) { ok = ok && slot / kBlockOrders < blocks; });
+    return ok;
+}
+
+template <typename Listener>
+bool BasicOrderBook<Listener>::loadCheckpoint(const std::string& path) {
+    checkpoint::Reader in;
+    if (!in.open(path)) return false;
+
+    char magic[sizeof(checkpoint::kMagic)];
+    uint32_t version = 0, blockSize = 0, infoSize = 0, levelSize = 0;
+    std::string symbol;
+    double tickSize = 0.0, lotSize = 0.0;
+    uint64_t storedNextId = 0;
+    if (!in.pod(magic) || !in.pod(version) || !in.pod(blockSize) || !in.pod(infoSize) || !in.pod(levelSize) ||
+        !in.string(symbol) || !in.pod(tickSize) || !in.pod(lotSize) || !in.pod(storedNextId)) {
+        return false;
+    }
+    if (std::memcmp(magic, checkpoint::kMagic, sizeof(magic)) != 0 || version != checkpoint::kVersion ||
+        blockSize != sizeof(OrderBlock) || infoSize != sizeof(OrderBlockInfo) || levelSize != sizeof(PriceLevel) ||
+        symbol != spec.symbol || tickSize != spec.tickSize || lotSize != spec.lotSize) {
+        return false;
+    }
+
+    // Restore into fresh structures and only swap them in once the whole file has parsed
+    std::pmr::memory_resource* memory = batchResults.get_allocator().resource();
+    PriceLadder loadedBids(true, 1, memory);
+    PriceLadder loadedAsks(false, 1, memory);
+    OrderPool loadedOrders(orders.capacity(), memory);
+    OrderIdIndex loadedIndex(0, memory);
+    if (!loadedBids.load(in) || !loadedAsks.load(in) || !loadedOrders.load(in) || !loadedIndex.load(in) ||
+        !in.atEnd() || !restoredLinksInRange(loadedBids, loadedAsks, loadedOrders, loadedIndex)) {
+        return false;
+    }
+
+    bids = std::move(loadedBids);
+    asks = std::move(loadedAsks);
+    orders = std::move(loadedOrders);
+    orderIndex = std::move(loadedIndex);
+    nextOrderId = storedNextId;
+    bidDepthCache.rebuild(bids);
+    askDepthCache.rebuild(asks);
+    return true;
+}
+
+template <typename Listener>
+double BasicOrderBook<Listener>::getBestBid() const {
+    if (!bids.empty()) return spec.toPrice(bids.bestTick());
+    return 0.0;
+}
+
+template <typename Listener>
+double BasicOrderBook<Listener>::getBestAsk() const {
+    if (!asks.empty()) return spec.toPrice(asks.bestTick());
+    return 0.0;
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::printSnapshot() const {
+    std::cout << "--- " << spec.symbol << " Book Snapshot ---\n";
+    std::cout << "Asks:\n";
+    // Asks print worst-to-best
+    auto topAsks = askDepth().first(std::min<size_t>(5, askDepth().size()));
+    for (auto it = topAsks.rbegin(); it != topAsks.rend(); ++it) {
+         std::cout << std::fixed << std::setprecision(2) << spec.toPrice(it->price) << " : "
+                   << spec.toQty(it->size) << "\n";
+    }
+    std::cout << "Bids:\n";
+    for (const DepthLevel& level : bidDepth().first(std::min<size_t>(5, bidDepth().size()))) {
+         std::cout << std::fixed << std::setprecision(2) << spec.toPrice(level.price) << " : "
+                   << spec.toQty(level.size) << "\n";
+    }
+    std::cout << "---------------------------\n";
+}
+
+extern template class BasicOrderBook<NullBookListener>;
+
 #endif
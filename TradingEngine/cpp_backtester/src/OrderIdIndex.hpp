@@ -0,0 +1,138 @@
+#ifndef ORDERIDINDEX_HPP
+#define ORDERIDINDEX_HPP
+
+#include "BookTypes.hpp"
+#include "Checkpoint.hpp"
+#include <algorithm>
+#include <vector>
+#include <memory_resource>
+#include <cstdint>
+#include <cstddef>
+
+// orderId -> pool slot map used by cancel/amend. Open addressing with linear probing over a
+// flat power-of-two table: a lookup is one multiply and (almost always) one cache line, versus
+// a bucket allocation and pointer chase per entry in std::unordered_map. Deletes use backward
+// shifting instead of tombstones so probe lengths don't degrade on cancel-heavy flow.
+// orderId 0 is reserved as the empty-slot marker.
+class OrderIdIndex {
+private:
+    struct Slot {
+        uint64_t orderId;
+        NodeId node;
+    };
+
+    std::pmr::vector<Slot> slots;
+    size_t mask = 0;
+    int shift = 64;
+    size_t count = 0;
+
+    size_t homeOf(uint64_t orderId) const {
+        // Fibonacci hashing: sequential ids spread evenly across the table
+        return static_cast<size_t>((orderId * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    void rehash(size_t newCapacity) {
+        std::pmr::vector<Slot> old(slots.get_allocator());
+        old.swap(slots);
+        slots.assign(newCapacity, Slot{0, kNullNode});
+        mask = newCapacity - 1;
+        shift = 64 - __builtin_ctzll(newCapacity);
+        count = 0;
+        for (const Slot& s : old) {
+            if (s.orderId != 0) insert(s.orderId, s.node);
+        }
+    }
+
+public:
+    explicit OrderIdIndex(size_t expectedOrders,
+                          std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : slots(memory) {
+        size_t capacity = 16;
+        while (capacity < expectedOrders * 2) capacity <<= 1;
+        rehash(capacity);
+    }
+
+    size_t size() const { return count; }
+    // Table slots, twice the ids it holds at most
+    size_t capacity() const { return slots.size(); }
+
+    // Empties the table in place, keeping its current (possibly grown) capacity
+    void clear() {
+        std::fill(slots.begin(), slots.end(), Slot{0, kNullNode});
+        count = 0;
+    }
+
+    // The table is stored as-is (not re-inserted), so probe runs come back exactly as saved
+    void save(checkpoint::Writer& out) const {
+        out.array(slots);
+        out.pod(static_cast<uint64_t>(count));
+    }
+
+    bool load(checkpoint::Reader& in) {
+        uint64_t stored = 0;
+        if (!in.array(slots) || !in.pod(stored)) return false;
+        size_t capacity = slots.size();
+        if (capacity < 16 || (capacity & (capacity - 1)) != 0 || stored * 2 > capacity) return in.fail();
+        mask = capacity - 1;
+        shift = 64 - __builtin_ctzll(capacity);
+        // The count must be right: it is what keeps the table under half full, so probes end
+        size_t used = std::count_if(slots.begin(), slots.end(), [](const Slot& s) { return s.orderId != 0; });
+        if (used != stored) return in.fail();
+        count = static_cast<size_t>(stored);
+        return true;
+    }
+
+    // Visits every (orderId, node) entry, in table order
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Slot& s : slots) {
+            if (s.orderId != 0) fn(s.orderId, s.node);
+        }
+    }
+
+    void insert(uint64_t orderId, NodeId node) {
+        // Keep load under 50% so probe sequences stay short
+        if ((count + 1) * 2 > slots.size()) rehash(slots.size() * 2);
+        size_t i = homeOf(orderId);
+        while (slots[i].orderId != 0 && slots[i].orderId != orderId) i = (i + 1) & mask;
+        if (slots[i].orderId == 0) ++count;
+        slots[i] = Slot{orderId, node};
+    }
+
+    // Hints the cache to fetch the home slot for an id that is about to be inserted or looked up
+    void prefetch(uint64_t orderId) const { __builtin_prefetch(&slots[homeOf(orderId)], 1); }
+
+    NodeId find(uint64_t orderId) const {
+        size_t i = homeOf(orderId);
+        while (slots[i].orderId != 0) {
+            if (slots[i].orderId == orderId) return slots[i].node;
+            i = (i + 1) & mask;
+        }
+        return kNullNode;
+    }
+
+    void erase(uint64_t orderId) {
+        size_t i = homeOf(orderId);
+        while (slots[i].orderId != orderId) {
+            if (slots[i].orderId == 0) return;
+            i = (i + 1) & mask;
+        }
+        // Backward-shift: pull later entries of the probe run into the hole if their
+        // home slot doesn't lie cyclically between the hole and their current position
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (slots[j].orderId == 0) break;
+            size_t home = homeOf(slots[j].orderId);
+            bool between = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (!between) {
+                slots[i] = slots[j];
+                i = j;
+            }
+        }
+        slots[i] = Slot{0, kNullNode};
+        --count;
+    }
+};
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef ORDERPOOL_HPP
+#define ORDERPOOL_HPP
+
+#include "BookTypes.hpp"
+#include "Checkpoint.hpp"
+#include <algorithm>
+#include <vector>
+#include <memory_resource>
+#include <cstddef>
+
+// Slab of resting orders owned by the OrderBook, stored as OrderBlocks (ids and sizes, what
+// matching touches) with a parallel OrderBlockInfo array (links, price, side). Blocks are
+// handed out from an intrusive free list, so adding, filling and cancelling orders never
+// touches the heap once the slab is warm. Each PriceLevel chains its blocks as a doubly
+// linked FIFO: appending, consuming from the front and cancelling from the middle are all
+// O(1), and only a block, never a single order, is ever linked or unlinked.
+class OrderPool {
+private:
+    std::pmr::vector<OrderBlock> blocks;
+    std::pmr::vector<OrderBlockInfo> infos;
+    NodeId freeHead = kNullNode;
+    size_t liveCount = 0;
+
+    static NodeId blockOf(NodeId slot) { return slot / kBlockOrders; }
+    static uint32_t positionOf(NodeId slot) { return slot % kBlockOrders; }
+
+    NodeId allocateBlock() {
+        if (freeHead != kNullNode) {
+            NodeId id = freeHead;
+            freeHead = infos[id].next;
+            return id;
+        }
+        // Fresh block. Only reallocates if the book outgrows the reserved capacity,
+        // which is safe because everything links by index.
+        blocks.emplace_back();
+        infos.emplace_back();
+        return static_cast<NodeId>(blocks.size() - 1);
+    }
+
+    // Drops an emptied block from its level's chain and puts it on the free list
+    void releaseBlock(PriceLevel& level, NodeId id) {
+        OrderBlockInfo& info = infos[id];
+        if (info.prev != kNullNode) infos[info.prev].next = info.next;
+        else level.head = info.next;
+        if (info.next != kNullNode) infos[info.next].prev = info.prev;
+        else level.tail = info.prev;
+        info.next = freeHead;
+        freeHead = id;
+    }
+
+public:
+    // Room for `capacity` resting orders with levels half-filling their last block on
+    // average; the slab grows past that if it has to
+    explicit OrderPool(size_t capacity, std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : blocks(memory), infos(memory) {
+        const size_t reserved = 2 * ((capacity + kBlockOrders - 1) / kBlockOrders);
+        blocks.reserve(reserved);
+        infos.reserve(reserved);
+    }
+
+    // A resting order, by slot
+    uint64_t orderId(NodeId slot) const { return blocks[blockOf(slot)].orderIds[positionOf(slot)]; }
+    Qty& size(NodeId slot) { return blocks[blockOf(slot)].sizes[positionOf(slot)]; }
+    Qty size(NodeId slot) const { return blocks[blockOf(slot)].sizes[positionOf(slot)]; }
+    // Price and side of the block the order rests in
+    const OrderBlockInfo& info(NodeId slot) const { return infos[blockOf(slot)]; }
+
+    OrderBlock& block(NodeId id) { return blocks[id]; }
+    const OrderBlock& block(NodeId id) const { return blocks[id]; }
+    const OrderBlockInfo& blockInfo(NodeId id) const { return infos[id]; }
+
+    size_t size() const { return liveCount; }
+    // Orders the reserved blocks hold
+    size_t capacity() const { return blocks.capacity() * kBlockOrders / 2; }
+    // Blocks handed out so far, queued or on the free list
+    size_t blockCount() const { return blocks.size(); }
+    NodeId freeListHead() const { return freeHead; }
+
+    // Calls fn(orderId) for every resting order, block by block in slab order
+    template <typename Fn>
+    void forEachOrder(Fn&& fn) const {
+        for (NodeId id = 0; id < blocks.size(); ++id) {
+            const OrderBlockInfo& info = infos[id];
+            if (info.live == 0) continue; // on the free list
+            for (uint32_t at = info.begin; at < info.end; ++at) {
+                if (blocks[id].sizes[at] > 0) fn(blocks[id].orderIds[at]);
+            }
+        }
+    }
+
+    // Drops every order but keeps the allocated slab
+    void clear() {
+        blocks.clear();
+        infos.clear();
+        freeHead = kNullNode;
+        liveCount = 0;
+    }
+
+    // Appends an order to the back of a level's queue (lowest time priority); returns its slot
+    NodeId pushBack(PriceLevel& level, Price price, bool isBuy, uint64_t orderId, Qty size) {
+        NodeId id = level.tail;
+        if (id == kNullNode || infos[id].end == kBlockOrders) {
+            const NodeId tail = level.tail;
+            id = allocateBlock();
+            infos[id] = OrderBlockInfo{price, tail, kNullNode, 0, 0, 0, isBuy};
+            if (tail != kNullNode) infos[tail].next = id;
+            else level.head = id;
+            level.tail = id;
+        }
+        OrderBlockInfo& info = infos[id];
+        const uint32_t at = info.end++;
+        blocks[id].orderIds[at] = orderId;
+        blocks[id].sizes[at] = size;
+        ++info.live;
+        ++level.orderCount;
+        ++liveCount;
+        return id * kBlockOrders + at;
+    }
+
+    // Takes an order out of anywhere in a level's queue, leaving a hole in its block (or
+    // freeing the block if it was the last order in it)
+    void remove(PriceLevel& level, NodeId slot) {
+        const NodeId id = blockOf(slot);
+        blocks[id].sizes[positionOf(slot)] = 0;
+        --level.orderCount;
+        --liveCount;
+        if (--infos[id].live == 0) releaseBlock(level, id);
+    }
+
+    // Fills up to `qty` lots from the front of a level's queue in time priority, calling
+    // fill(orderId, traded, done) for each resting order it trades with (`done` once the
+    // order has nothing left, and is out of the queue). Returns the quantity left unfilled.
+    template <typename Fill>
+    Qty consumeFront(PriceLevel& level, Qty qty, Fill&& fill) {
+        while (qty > 0 && level.head != kNullNode) {
+            const NodeId id = level.head;
+            OrderBlock& block = blocks[id];
+            OrderBlockInfo& info = infos[id];
+            uint32_t at = info.begin;
+            for (; at < info.end && qty > 0; ++at) {
+                Qty& resting = block.sizes[at];
+                if (resting == 0) continue;
+                const Qty traded = std::min(qty, resting);
+                qty -= traded;
+                resting -= traded;
+                if (resting > 0) {
+                    // The aggressor ran out first; this order stays at the front
+                    fill(block.orderIds[at], traded, false);
+                    break;
+                }
+                --info.live;
+                --level.orderCount;
+                --liveCount;
+                fill(block.orderIds[at], traded, true);
+            }
+            if (info.live == 0) {
+                releaseBlock(level, id);
+            } else {
+                info.begin = static_cast<uint16_t>(at);
+                break;
+            }
+        }
+        return qty;
+    }
+
+    void save(checkpoint::Writer& out) const {
+        out.array(blocks);
+        out.array(infos);
+        out.pod(freeHead);
+        out.pod(static_cast<uint64_t>(liveCount));
+    }
+
+    bool load(checkpoint::Reader& in) {
+        uint64_t live = 0;
+        if (!in.array(blocks) || !in.array(infos) || !in.pod(freeHead) || !in.pod(live)) return false;
+        if (infos.size() != blocks.size() || live > blocks.size() * kBlockOrders ||
+            (freeHead != kNullNode && freeHead >= blocks.size())) {
+            return in.fail();
+        }
+        liveCount = static_cast<size_t>(live);
+        return true;
+    }
+};
+
+#endif
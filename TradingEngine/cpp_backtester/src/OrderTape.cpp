@@ -0,0 +1,88 @@
+#include "OrderTape.hpp"
+#include "ColumnFile.hpp"
+#include "CsvScanner.hpp"
+#include <array>
+#include <vector>
+
+namespace {
+
+struct ParsedOrders {
+    std::vector<uint8_t> sides;
+    std::vector<Price> prices;
+    std::vector<Qty> sizes;
+};
+
+// side, price, amount
+constexpr std::array<columns::Type, 3> kSchema = {columns::Type::UInt8, columns::Type::Int64,
+                                                  columns::Type::Int64};
+
+} // namespace
+
+void OrderTape::clear() {
+    sides = {};
+    prices = {};
+    sizes = {};
+    storage.reset();
+}
+
+bool OrderTape::loadCsv(const std::string& path, unsigned threads) {
+    MappedFile file;
+    if (!file.open(path, MappedFile::Access::Sequential)) return false;
+
+    auto parsedColumns = std::make_shared<ParsedOrders>();
+    ParsedOrders& c = *parsedColumns;
+    auto resize = [&](size_t rows) {
+        c.sides.resize(rows);
+        c.prices.resize(rows);
+        c.sizes.resize(rows);
+    };
+    bool parsed = csv::parseParallel(csv::skipHeader(file.text()), threads, resize,
+                                     [&](std::string_view chunk, size_t row) {
+        return csv::forEachLine(chunk, [&](std::string_view line) {
+            csv::Fields fields(line);
+            std::string_view side;
+            double price = 0.0, amount = 0.0;
+            if (!fields.next(side) || !fields.next(price) || !fields.next(amount)) return false;
+            c.sides[row] = side == "buy";
+            c.prices[row] = spec.toTicks(price);
+            c.sizes[row] = spec.toLots(amount);
+            ++row;
+            return true;
+        });
+    });
+    if (!parsed) {
+        clear();
+        return false;
+    }
+    sides = c.sides;
+    prices = c.prices;
+    sizes = c.sizes;
+    storage = std::move(parsedColumns);
+    return true;
+}
+
+bool OrderTape::load(const std::string& path, unsigned threads) {
+    columns::SourceStamp source;
+    if (!columns::SourceStamp::of(path, source)) return false;
+    std::string cachePath = columns::cachePathFor(path);
+    // Ticks and lots depend on the spec, so a cache built with other sizes is stale
+    const double scale[2] = {spec.tickSize, spec.lotSize};
+
+    auto cache = std::make_shared<columns::Reader>();
+    if (cache->open(cachePath, columns::Kind::OrderTape, kSchema, source, scale)) {
+        sides = cache->column<uint8_t>(0);
+        prices = cache->column<Price>(1);
+        sizes = cache->column<Qty>(2);
+        storage = std::move(cache);
+        return true;
+    }
+
+    if (!loadCsv(path, threads)) return false;
+    const columns::ColumnData data[] = {
+        {columns::Type::UInt8, sides.data()},
+        {columns::Type::Int64, prices.data()},
+        {columns::Type::Int64, sizes.data()},
+    };
+    columns::write(cachePath, columns::Kind::OrderTape, source, scale, size(), data);
+    return true;
+}
@@ -0,0 +1,53 @@
+#ifndef ORDERTAPE_HPP
+#define ORDERTAPE_HPP
+
+#include "BookTypes.hpp"
+#include "SymbolSpec.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+// An order-book CSV (side,price,amount) parsed once into columns already converted to
+// ticks/lots, so repeated runs over the same data replay from memory instead of reopening
+// and reparsing the file every time. Columns rather than rows keep each field contiguous
+// for whatever scans them.
+//
+// The columns are read-only views over storage shared between copies of the tape: either
+// arrays parsed from the CSV, or the mapped binary cache next to it (see ColumnFile.hpp).
+class OrderTape {
+public:
+    OrderTape() = default;
+    explicit OrderTape(const SymbolSpec& spec) : spec(spec) {}
+
+    // Replaces the contents with the rows of `path` (header line skipped), converted with
+    // this tape's SymbolSpec. `threads` = 0 picks a worker count from the file size.
+    // Returns false if the file can't be read or a row is malformed.
+    bool loadCsv(const std::string& path, unsigned threads = 0);
+
+    // Like loadCsv, but maps "<path>.cols" when it was built from this CSV with the same tick
+    // and lot sizes, and otherwise parses the CSV and (re)writes the cache for next time. A
+    // cache that can't be written is not an error.
+    bool load(const std::string& path, unsigned threads = 0);
+
+    const SymbolSpec& symbolSpec() const { return spec; }
+    size_t size() const { return prices.size(); }
+    bool empty() const { return prices.empty(); }
+
+    bool isBuy(size_t i) const { return sides[i] != 0; }
+    Price price(size_t i) const { return prices[i]; }
+    Qty size(size_t i) const { return sizes[i]; }
+    OrderRequest request(size_t i) const { return OrderRequest{prices[i], sizes[i], sides[i] != 0}; }
+
+private:
+    SymbolSpec spec;
+    std::span<const uint8_t> sides; // 1 = buy
+    std::span<const Price> prices;  // ticks
+    std::span<const Qty> sizes;     // lots
+    std::shared_ptr<const void> storage;
+
+    void clear();
+};
+
+#endif
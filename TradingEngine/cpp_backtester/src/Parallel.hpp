@@ -0,0 +1,39 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Resolves a requested worker count: 0 means one per hardware thread
+inline unsigned workerCount(unsigned requested) {
+    return requested > 0 ? requested : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Calls fn(i) for every i in [0, count) on up to `threads` workers (0 = one per hardware
+// thread). Indices are handed out one at a time from a shared counter, so uneven jobs
+// balance themselves; the calling thread works too. Returns once every call has finished.
+template <typename Fn>
+void parallelFor(size_t count, unsigned threads, Fn&& fn) {
+    size_t workers = std::min<size_t>(workerCount(threads), count);
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+    std::atomic<size_t> next{0};
+    auto work = [&] {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            fn(i);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w) pool.emplace_back(work);
+    work();
+    for (auto& thread : pool) thread.join();
+}
+
+#endif
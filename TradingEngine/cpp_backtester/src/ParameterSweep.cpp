@@ -0,0 +1,75 @@
+#include "ParameterSweep.hpp"
+#include <charconv>
+#include <fstream>
+#include <system_error>
+
+namespace {
+
+bool parseNumber(std::string_view text, double& out) {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+} // namespace
+
+bool ParamGrid::add(std::string_view arg, std::string& error) {
+    size_t eq = arg.find('=');
+    if (eq == std::string_view::npos || eq == 0 || eq + 1 == arg.size()) {
+        error = "expected name=values, got '" + std::string(arg) + "'";
+        return false;
+    }
+    std::string name(arg.substr(0, eq));
+    std::string_view spec = arg.substr(eq + 1);
+    std::vector<double>& out = values[name];
+    out.clear();
+
+    if (spec.find(':') != std::string_view::npos) {
+        // start:stop:step, stop inclusive
+        size_t c1 = spec.find(':');
+        size_t c2 = spec.find(':', c1 + 1);
+        double start = 0, stop = 0, step = 0;
+        if (c2 == std::string_view::npos || !parseNumber(spec.substr(0, c1), start) ||
+            !parseNumber(spec.substr(c1 + 1, c2 - c1 - 1), stop) || !parseNumber(spec.substr(c2 + 1), step) ||
+            step <= 0 || stop < start) {
+            error = "bad range for " + name + " (want start:stop:step with step > 0)";
+            return false;
+        }
+        // Counting steps rather than accumulating keeps 0.1-style steps from drifting
+        size_t count = static_cast<size_t>((stop - start) / step + 1e-9) + 1;
+        for (size_t k = 0; k < count; ++k) out.push_back(start + k * step);
+        return true;
+    }
+
+    while (!spec.empty()) {
+        size_t comma = spec.find(',');
+        double value = 0;
+        if (!parseNumber(spec.substr(0, comma), value)) {
+            error = "bad value list for " + name;
+            return false;
+        }
+        out.push_back(value);
+        spec = comma == std::string_view::npos ? std::string_view() : spec.substr(comma + 1);
+    }
+    return true;
+}
+
+void SweepTable::rank() {
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](const SweepRow& a, const SweepRow& b) { return rankedAbove(a.stats, b.stats); });
+}
+
+bool SweepTable::writeCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+    out << "rank,strategy";
+    for (const std::string& name : paramNames) out << ',' << name;
+    out << ",aggression,total_trades,win_rate,simulated_pnl,max_drawdown,sharpe_ratio\n";
+    for (size_t r = 0; r < rows.size(); ++r) {
+        const SweepRow& row = rows[r];
+        out << r + 1 << ',' << strategy;
+        for (double value : row.params) out << ',' << value;
+        out << ',' << row.aggression << ',' << row.stats.totalTrades << ',' << row.stats.winRate() << ','
+            << row.stats.totalPnL << ',' << row.stats.maxDrawdown << ',' << row.stats.sharpeRatio << '\n';
+    }
+    return static_cast<bool>(out);
+}
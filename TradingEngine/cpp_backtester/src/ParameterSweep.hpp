@@ -0,0 +1,134 @@
+#ifndef PARAMETERSWEEP_HPP
+#define PARAMETERSWEEP_HPP
+
+#include "CandleBacktest.hpp"
+#include "CandleSeries.hpp"
+#include "IndicatorCache.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Grid search over a candle strategy's parameters. Every combination in the grid (times
+// every aggression) is one job; all jobs read the same candle series and the same shared
+// indicator columns, run in parallel, and come back as one ranked table.
+
+// Values to try for each named parameter. Parameters not in the grid keep their defaults.
+struct ParamGrid {
+    std::map<std::string, std::vector<double>> values;
+
+    // Adds one "name=v1,v2,..." or "name=start:stop:step" argument. Returns false with
+    // `error` set if it is malformed.
+    bool add(std::string_view arg, std::string& error);
+};
+
+// Ranking used to pick the best configuration: higher Sharpe ratio, then higher PnL
+inline bool rankedAbove(const BacktestStats& a, const BacktestStats& b) {
+    if (a.sharpeRatio != b.sharpeRatio) return a.sharpeRatio > b.sharpeRatio;
+    return a.totalPnL > b.totalPnL;
+}
+
+struct SweepRow {
+    std::vector<double> params; // in SweepTable::paramNames order
+    double aggression = 1.0;
+    BacktestStats stats;
+};
+
+struct SweepTable {
+    std::string strategy;
+    std::vector<std::string> paramNames;
+    std::vector<SweepRow> rows;
+    size_t indicatorColumns = 0; // distinct indicator columns computed for the sweep
+
+    // Best first: by Sharpe ratio, then PnL
+    void rank();
+    // Whole table as CSV, best first
+    bool writeCsv(const std::string& path) const;
+};
+
+// Sets strategy parameter `name`; returns false if the strategy has no such parameter
+template <typename Strategy>
+bool setParam(Strategy& strategy, std::string_view name, double value) {
+    bool found = false;
+    Strategy::params(strategy, [&](const char* paramName, auto& field) {
+        if (name != paramName) return;
+        using Field = std::remove_reference_t<decltype(field)>;
+        if constexpr (std::is_integral_v<Field>) {
+            field = value >= 1 ? static_cast<Field>(std::llround(value)) : Field(0);
+        } else {
+            field = static_cast<Field>(value);
+        }
+        found = true;
+    });
+    return found;
+}
+
+// Expands the grid into one configuration per valid combination of the strategy's
+// parameters. Returns false with `error` set if the grid names a parameter the strategy
+// doesn't have ("aggression" is always accepted; it's applied per job, not here).
+template <typename Strategy>
+bool expandGrid(const ParamGrid& grid, std::vector<Strategy>& configs, std::vector<std::string>& names,
+                std::string& error) {
+    names.clear();
+    const Strategy defaults{};
+    Strategy::params(defaults, [&](const char* name, const auto&) { names.push_back(name); });
+    for (const auto& [name, values] : grid.values) {
+        if (name != "aggression" && std::find(names.begin(), names.end(), name) == names.end()) {
+            error = "unknown parameter '" + name + "' for " + Strategy::kName;
+            return false;
+        }
+    }
+
+    configs.assign(1, Strategy{});
+    for (const std::string& name : names) {
+        auto it = grid.values.find(name);
+        if (it == grid.values.end()) continue;
+        std::vector<Strategy> expanded;
+        expanded.reserve(configs.size() * it->second.size());
+        for (const Strategy& config : configs) {
+            for (double value : it->second) {
+                expanded.push_back(config);
+                setParam(expanded.back(), name, value);
+            }
+        }
+        configs = std::move(expanded);
+    }
+    std::erase_if(configs, [](const Strategy& config) { return !config.valid(); });
+    return true;
+}
+
+// Runs every combination in `grid` over `candles` on up to `threads` workers (0 = one per
+// hardware thread). The table comes back unranked, in grid order.
+template <typename Strategy>
+bool runSweep(const CandleSeries& candles, const ParamGrid& grid, unsigned threads, SweepTable& table,
+              std::string& error) {
+    std::vector<Strategy> configs;
+    table = SweepTable{};
+    table.strategy = Strategy::kName;
+    if (!expandGrid(grid, configs, table.paramNames, error)) return false;
+    auto aggressionIt = grid.values.find("aggression");
+    const std::vector<double> aggressions =
+        aggressionIt != grid.values.end() ? aggressionIt->second : std::vector<double>{1.0};
+
+    // Build every column up front; after this the cache is only read
+    IndicatorCache indicators(candles);
+    for (Strategy& config : configs) config.prepare(indicators);
+    table.indicatorColumns = indicators.columnCount();
+
+    table.rows.resize(configs.size() * aggressions.size());
+    parallelFor(table.rows.size(), threads, [&](size_t job) {
+        const Strategy& config = configs[job / aggressions.size()];
+        SweepRow& row = table.rows[job];
+        Strategy::params(config, [&](const char*, const auto& field) { row.params.push_back(double(field)); });
+        row.aggression = aggressions[job % aggressions.size()];
+        row.stats = backtestCandles(config, candles, row.aggression);
+    });
+    return true;
+}
+
+#endif
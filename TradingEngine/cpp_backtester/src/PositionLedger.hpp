@@ -0,0 +1,215 @@
+#ifndef POSITIONLEDGER_HPP
+#define POSITIONLEDGER_HPP
+
+#include "BookEvents.hpp"
+#include "OrderBook.hpp"
+#include "OrderIdIndex.hpp"
+#include "PriceLadder.hpp"
+#include "SymbolSpec.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fee rates as a fraction of traded notional
+struct FeeSchedule {
+    double maker = 0.0; // the strategy's order was resting
+    double taker = 0.0; // the strategy's order was the aggressor
+};
+
+// Position and PnL for one strategy on one book, driven by the book's own fill events
+// rather than simulated from prices. Orders the strategy submits through the ledger are
+// marked as its own; every Trade that touches one of them moves the position at the fill
+// price, realizes PnL on whatever it closes (average-cost basis) and charges the maker or
+// taker fee. The open position is marked to the book's mid.
+//
+// All state is allocated up front: owned ids live in an OrderIdIndex sized for
+// `maxOpenOrders` (it never grows, because submit() refuses past that), with their unfilled
+// quantity in a parallel slot array. A fill is two probes of that small table, and events
+// for other orders return straight away when the strategy has nothing working.
+class PositionLedger {
+public:
+    PositionLedger(const SymbolSpec& spec, FeeSchedule fees, size_t maxOpenOrders = 256)
+        : unit(spec.tickSize * spec.lotSize), tickSize(spec.tickSize), lotSize(spec.lotSize), feeRates(fees),
+          owned(maxOpenOrders), remainingLots(maxOpenOrders), freeSlots(maxOpenOrders) {
+        reset();
+    }
+
+    // Forgets every order and zeroes the position and PnL (capacity is kept)
+    void reset() {
+        owned.clear();
+        for (size_t i = 0; i < freeSlots.size(); ++i) freeSlots[i] = static_cast<NodeId>(freeSlots.size() - 1 - i);
+        freeCount = freeSlots.size();
+        positionLots = 0;
+        avgEntryTicks = 0;
+        markTicks = 0;
+        marked = false;
+        realized = 0;
+        feesPaid = 0;
+        counters = Counters{};
+    }
+
+    // Submits an order for the strategy. The id is claimed before the book sees the order,
+    // so fills it takes on arrival are already counted. Returns 0 (and sends nothing) if the
+    // ledger is tracking maxOpenOrders working orders already.
+    template <typename Book>
+    uint64_t submit(Book& book, bool isBuy, Price price, Qty size) {
+        if (size <= 0 || freeCount == 0) return 0;
+        uint64_t orderId = book.upcomingOrderId();
+        NodeId slot = freeSlots[--freeCount];
+        remainingLots[slot] = size;
+        owned.insert(orderId, slot);
+        ++counters.ordersSubmitted;
+        book.processOrderTicks(isBuy, price, size);
+        return orderId;
+    }
+
+    // Cancels a strategy order if it is still working; returns false otherwise
+    template <typename Book>
+    bool cancel(Book& book, uint64_t orderId) {
+        return orderId != 0 && working(orderId) && book.cancelOrder(orderId);
+    }
+
+    // Amends a working strategy order (see OrderBook::amendOrderTicks); returns false if it
+    // isn't working. Strategy amends must come through here rather than straight to the
+    // book: a price change or size-up pulls the order and resubmits it under the same id,
+    // and the cancel half of that would otherwise end the ledger's claim on the id, so
+    // the fills of the resubmitted order would be taken for someone else's.
+    template <typename Book>
+    bool amend(Book& book, uint64_t orderId, Price newPrice, Qty newSize) {
+        if (newSize <= 0) return cancel(book, orderId);
+        if (orderId == 0 || !working(orderId)) return false;
+        // Whatever the book does, the order ends up working newSize lots less any fills
+        // on the way back in, which onTrade takes off as they happen
+        remainingLots[owned.find(orderId)] = newSize;
+        amending = orderId;
+        book.amendOrderTicks(orderId, newPrice, newSize);
+        amending = 0;
+        return true;
+    }
+
+    // True while a strategy order has unfilled quantity (resting, or on its way in)
+    bool working(uint64_t orderId) const { return owned.size() > 0 && owned.find(orderId) != kNullNode; }
+
+    // ─── Book events (see LedgerListener) ────────────────────────────
+
+    void onTrade(const Trade& trade) {
+        if (owned.size() == 0) return;
+        if (consume(trade.aggressorId, trade.size)) fill(trade.aggressorIsBuy, trade.price, trade.size, false);
+        if (consume(trade.restingId, trade.size)) fill(!trade.aggressorIsBuy, trade.price, trade.size, true);
+    }
+
+    void onCancel(uint64_t orderId, Qty qty) {
+        if (owned.size() > 0 && orderId != amending) consume(orderId, qty);
+    }
+
+    // Marks the position to the mid of the given best prices; with either side empty the
+    // previous mark stands
+    void mark(Price bestBid, Price bestAsk) {
+        if (bestBid == PriceLadder::kNoTick || bestAsk == PriceLadder::kNoTick) return;
+        markTicks = (static_cast<double>(bestBid) + static_cast<double>(bestAsk)) * 0.5;
+        marked = true;
+    }
+
+    // ─── Position and PnL (quote currency) ───────────────────────────
+
+    Qty position() const { return positionLots; }
+    double positionQty() const { return positionLots * lotSize; }
+    double averageEntry() const { return avgEntryTicks * tickSize; }
+    double markPrice() const { return markTicks * tickSize; }
+    double realizedPnL() const { return realized; }
+    double unrealizedPnL() const { return (markTicks - avgEntryTicks) * static_cast<double>(positionLots) * unit; }
+    double fees() const { return feesPaid; }
+    // Realized + unrealized, net of fees
+    double equity() const { return realized + unrealizedPnL() - feesPaid; }
+
+    struct Counters {
+        uint64_t ordersSubmitted = 0;
+        uint64_t fills = 0;
+        uint64_t makerFills = 0;
+        Qty tradedLots = 0;
+        uint64_t closingFills = 0; // fills that reduced the position
+        uint64_t winningCloses = 0; // ... at a profit before fees
+    };
+    const Counters& stats() const { return counters; }
+    double tradedQty() const { return counters.tradedLots * lotSize; }
+
+private:
+    double unit; // quote currency per tick-lot
+    double tickSize;
+    double lotSize;
+    FeeSchedule feeRates;
+
+    OrderIdIndex owned; // strategy order id -> slot in remainingLots
+    std::vector<Qty> remainingLots;
+    std::vector<NodeId> freeSlots;
+    size_t freeCount = 0;
+    uint64_t amending = 0; // the order amend() is replacing, whose cancel events it ignores
+
+    Qty positionLots = 0;  // signed: long > 0
+    double avgEntryTicks = 0;
+    double markTicks = 0;
+    bool marked = false;
+    double realized = 0;
+    double feesPaid = 0;
+    Counters counters;
+
+    // Takes qty off a strategy order's unfilled amount, dropping the order once nothing is
+    // left. Returns false if the id isn't the strategy's.
+    bool consume(uint64_t orderId, Qty qty) {
+        NodeId slot = owned.find(orderId);
+        if (slot == kNullNode) return false;
+        remainingLots[slot] -= qty;
+        if (remainingLots[slot] <= 0) {
+            owned.erase(orderId);
+            freeSlots[freeCount++] = slot;
+        }
+        return true;
+    }
+
+    void fill(bool isBuy, Price price, Qty qty, bool maker) {
+        const Qty signedQty = isBuy ? qty : -qty;
+        const double px = static_cast<double>(price);
+        ++counters.fills;
+        if (maker) ++counters.makerFills;
+        counters.tradedLots += qty;
+        feesPaid += (maker ? feeRates.maker : feeRates.taker) * px * static_cast<double>(qty) * unit;
+        if (!marked) {
+            markTicks = px;
+            marked = true;
+        }
+
+        if (positionLots == 0 || (positionLots > 0) == isBuy) {
+            // Opening or adding: blend into the average entry
+            const double held = static_cast<double>(positionLots > 0 ? positionLots : -positionLots);
+            avgEntryTicks = (avgEntryTicks * held + px * static_cast<double>(qty)) / (held + static_cast<double>(qty));
+            positionLots += signedQty;
+            return;
+        }
+
+        // Reducing, and possibly flipping through flat
+        const Qty held = positionLots > 0 ? positionLots : -positionLots;
+        const Qty closed = qty < held ? qty : held;
+        const double pnl = (px - avgEntryTicks) * static_cast<double>(positionLots > 0 ? closed : -closed) * unit;
+        realized += pnl;
+        ++counters.closingFills;
+        if (pnl > 0) ++counters.winningCloses;
+        positionLots += signedQty;
+        if (positionLots == 0) avgEntryTicks = 0;
+        else if (qty > held) avgEntryTicks = px; // the remainder opened a position the other way
+    }
+};
+
+// Book listener that feeds fills and cancels to a PositionLedger. Use as
+// BasicOrderBook<LedgerListener> book(spec, capacity, LedgerListener{&ledger});
+struct LedgerListener {
+    PositionLedger* ledger;
+
+    void onTrade(const Trade& trade) { ledger->onTrade(trade); }
+    void onAdd(uint64_t, bool, Price, Qty) {}
+    void onCancel(uint64_t orderId, bool, Price, Qty qty) { ledger->onCancel(orderId, qty); }
+    void onLevelChange(bool, Price, Qty) {}
+};
+
+using LedgerBook = BasicOrderBook<LedgerListener>;
+
+#endif
@@ -0,0 +1,154 @@
+#include "PriceLadder.hpp"
+#include <algorithm>
+#include <iterator>
+
+PriceLadder::PriceLadder(bool isBid, size_t initialLevels, std::pmr::memory_resource* memory)
+    : isBid(isBid), levels(std::clamp<size_t>(initialLevels, 1, kMaxLevels), memory), occupied(memory),
+      overflow(memory) {
+    occupied.reset(levels.size());
+}
+
+PriceLevel& PriceLadder::outsideLevel(Price tick) {
+    if (!overflow.empty()) {
+        auto it = overflow.find(tick);
+        if (it != overflow.end()) return it->second;
+    }
+    // A new best always goes in the window (recenter spills whatever no longer fits); a
+    // worse price does only if the window can stretch to cover it
+    bool fits = best == kNoTick || isBetter(tick, best);
+    if (!fits) {
+        Price lo = std::min(tick, baseTick + static_cast<Price>(occupied.findNext(0)));
+        Price hi = std::max(tick, baseTick + static_cast<Price>(occupied.findPrev(levels.size() - 1)));
+        fits = static_cast<size_t>(hi - lo) < kMaxLevels;
+    }
+    if (!fits) return overflow.try_emplace(tick, PriceLevel(tick)).first->second;
+    recenter(tick);
+    return levels[tick - baseTick];
+}
+
+Price PriceLadder::overflowWorseThan(Price tick) const {
+    if (isBid) {
+        auto it = overflow.lower_bound(tick);
+        return it == overflow.begin() ? kNoTick : std::prev(it)->first;
+    }
+    auto it = overflow.upper_bound(tick);
+    return it == overflow.end() ? kNoTick : it->first;
+}
+
+void PriceLadder::recenter(Price tick) {
+    // Find the live range we have to keep, including the new tick
+    Price lo = tick, hi = tick;
+    if (best != kNoTick) {
+        lo = std::min(lo, baseTick + static_cast<Price>(occupied.findNext(0)));
+        hi = std::max(hi, baseTick + static_cast<Price>(occupied.findPrev(levels.size() - 1)));
+    }
+
+    // Keep at least as much headroom as live range so a drifting market doesn't
+    // recenter on every new level, up to the window cap
+    size_t span = static_cast<size_t>(hi - lo) + 1;
+    size_t capacity = levels.size();
+    while (span * 2 > capacity && capacity < kMaxLevels) capacity = std::min(capacity * 2, kMaxLevels);
+
+    // Too wide even so: `tick` is a new best, so anchor on it and let the far end spill
+    Price newBase = span <= capacity ? lo - static_cast<Price>((capacity - span) / 2) : anchoredBase(tick, capacity);
+    rebuild(newBase, capacity);
+}
+
+void PriceLadder::promoteOverflow() {
+    // The window ran out of levels; the best overflow level becomes the touch
+    best = isBid ? overflow.rbegin()->first : overflow.begin()->first;
+    rebuild(anchoredBase(best, levels.size()), levels.size());
+}
+
+Price PriceLadder::anchoredBase(Price tick, size_t capacity) const {
+    // A quarter of the window on the better side of `tick`, the rest towards worse prices
+    Price better = static_cast<Price>(capacity / 4);
+    return isBid ? tick - static_cast<Price>(capacity) + better + 1 : tick - better;
+}
+
+void PriceLadder::rebuild(Price newBase, size_t capacity) {
+    const Price newEnd = newBase + static_cast<Price>(capacity);
+    std::pmr::memory_resource* memory = levels.get_allocator().resource();
+    std::pmr::vector<PriceLevel> recentered(capacity, memory);
+    LevelBitmap moved(memory);
+    moved.reset(capacity);
+    // Overflow levels the new window covers move in first, then live window levels either
+    // move across or spill out past the worse edge
+    for (auto it = overflow.lower_bound(newBase); it != overflow.end() && it->first < newEnd;) {
+        size_t slot = static_cast<size_t>(it->first - newBase);
+        recentered[slot] = it->second;
+        moved.set(slot);
+        it = overflow.erase(it);
+    }
+    for (size_t i = occupied.findNext(0); i != LevelBitmap::npos; i = occupied.findNext(i + 1)) {
+        Price tick = baseTick + static_cast<Price>(i);
+        if (tick >= newBase && tick < newEnd) {
+            size_t slot = static_cast<size_t>(tick - newBase);
+            recentered[slot] = levels[i];
+            moved.set(slot);
+        } else {
+            overflow.emplace(tick, levels[i]);
+        }
+    }
+    levels.swap(recentered);
+    occupied = std::move(moved);
+    baseTick = newBase;
+}
+
+void PriceLadder::clear() {
+    // Only occupied slots can hold anything, so this is proportional to the live levels
+    for (size_t i = occupied.findNext(0); i != LevelBitmap::npos; i = occupied.findNext(i + 1)) {
+        levels[i] = PriceLevel();
+        occupied.clear(i);
+    }
+    overflow.clear();
+    best = kNoTick;
+    activeLevels = 0;
+}
+
+void PriceLadder::save(checkpoint::Writer& out) const {
+    out.pod(static_cast<uint8_t>(isBid));
+    out.pod(baseTick);
+    out.pod(best);
+    out.pod(static_cast<uint64_t>(activeLevels));
+    out.array(levels);
+    occupied.save(out);
+    std::vector<PriceLevel> far;
+    far.reserve(overflow.size());
+    for (const auto& entry : overflow) far.push_back(entry.second);
+    out.array(far);
+}
+
+bool PriceLadder::load(checkpoint::Reader& in) {
+    uint8_t side = 0;
+    uint64_t active = 0;
+    std::vector<PriceLevel> far;
+    if (!in.pod(side) || !in.pod(baseTick) || !in.pod(best) || !in.pod(active) || !in.array(levels) ||
+        !occupied.load(in) || !in.array(far)) {
+        return false;
+    }
+    if (side != static_cast<uint8_t>(isBid) || levels.empty() || levels.size() > kMaxLevels ||
+        occupied.bitCount() != levels.size() || active > levels.size() + far.size() ||
+        (best != kNoTick && !inWindow(best)) || (best == kNoTick && !far.empty())) {
+        return in.fail();
+    }
+    // Occupied slots must hold live levels for their own tick, with the best one first
+    size_t occupiedCount = 0;
+    for (size_t i = occupied.findNext(0); i != LevelBitmap::npos; i = occupied.findNext(i + 1), ++occupiedCount) {
+        if (levels[i].empty() || levels[i].price != baseTick + static_cast<Price>(i) || isBetter(levels[i].price, best)) {
+            return in.fail();
+        }
+    }
+    if (best != kNoTick && !occupied.test(static_cast<size_t>(best - baseTick))) return in.fail();
+    // Overflow levels must be live, sorted and worse than the whole window
+    overflow.clear();
+    for (const PriceLevel& level : far) {
+        if (level.empty() || inWindow(level.price) || isBetter(level.price, best) ||
+            !overflow.try_emplace(level.price, level).second) {
+            return in.fail();
+        }
+    }
+    if (occupiedCount + overflow.size() != active) return in.fail();
+    activeLevels = static_cast<size_t>(active);
+    return true;
+}
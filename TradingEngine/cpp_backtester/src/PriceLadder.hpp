@@ -0,0 +1,162 @@
+#ifndef PRICELADDER_HPP
+#define PRICELADDER_HPP
+
+#include "BookTypes.hpp"
+#include "LevelBitmap.hpp"
+#include "Checkpoint.hpp"
+#include <map>
+#include <vector>
+#include <memory_resource>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+// One side of the book stored as a direct-indexed array of price levels.
+// levels[i] is the level for tick (baseTick + i), so finding the level for a price is a
+// subtraction rather than a search, and nothing is ever sorted: the array index *is* the
+// price ordering. When a price falls outside the window the ladder recenters around the
+// live range (doubling if it no longer fits), keeping insert/lookup O(1) amortized.
+//
+// Occupancy is mirrored in a LevelBitmap, so moving to the next non-empty level after the
+// best one empties is a bitset scan rather than a walk over empty slots.
+//
+// The window never grows past kMaxLevels ticks and always contains the best price. Levels
+// too far from the touch to fit (a stray bid at one cent under a $60k book) are kept in a
+// sorted overflow map instead, which therefore only ever holds prices worse than everything
+// in the window. A recenter pulls overflow levels that now fit back into the array, and
+// when the window runs out of levels the best overflow level is promoted and the window
+// moves to it. Memory is bounded by the window plus one map node per far level.
+class PriceLadder {
+public:
+    static constexpr Price kNoTick = std::numeric_limits<Price>::min();
+    static constexpr size_t kInitialLevels = 4096;
+    // 2^18 ticks (8 MB of levels): +/-$1,300 around a cent-tick BTC touch
+    static constexpr size_t kMaxLevels = size_t(1) << 18;
+
+    PriceLadder(bool isBid, size_t initialLevels = kInitialLevels,
+                std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    bool empty() const { return activeLevels == 0; }
+    size_t levelCount() const { return activeLevels; }
+    Price bestTick() const { return best; }
+    PriceLevel& bestLevel() { return levels[best - baseTick]; }
+    const PriceLevel& bestLevel() const { return levels[best - baseTick]; }
+
+    // True if `tick` is a better price than `other` for this side
+    bool isBetter(Price tick, Price other) const { return isBid ? tick > other : tick < other; }
+
+    // Returns the (possibly empty) level for a tick, recentering the window first if needed.
+    // Callers report empty -> non-empty transitions via activate(). The reference stays
+    // valid until the next levelAt() or deactivate() on this side.
+    PriceLevel& levelAt(Price tick) {
+        if (inWindow(tick)) return levels[tick - baseTick];
+        return outsideLevel(tick);
+    }
+
+    // Hints the cache to fetch the level for `tick` ahead of use. Prices outside the
+    // current window are skipped; they will recenter when actually inserted.
+    void prefetchLevel(Price tick) const {
+        Price slot = tick - baseTick;
+        if (slot >= 0 && slot < static_cast<Price>(levels.size())) {
+            __builtin_prefetch(&levels[slot], 1);
+        }
+    }
+
+    void activate(Price tick) {
+        ++activeLevels;
+        if (!inWindow(tick)) return; // overflow levels are live while they're in the map
+        PriceLevel& level = levels[tick - baseTick];
+        level.price = tick;
+        occupied.set(static_cast<size_t>(tick - baseTick));
+        if (best == kNoTick || isBetter(tick, best)) best = tick;
+    }
+
+    // Called once the level at `tick` has become empty. If it was the best level, the
+    // bitmap gives the next non-empty one towards worse prices.
+    void deactivate(Price tick) {
+        --activeLevels;
+        if (!inWindow(tick)) {
+            overflow.erase(tick);
+            return;
+        }
+        size_t slot = static_cast<size_t>(tick - baseTick);
+        occupied.clear(slot);
+        if (tick != best) return;
+        if (activeLevels == 0) {
+            best = kNoTick;
+            return;
+        }
+        size_t next = nextWorseSlot(slot);
+        if (next != LevelBitmap::npos) best = baseTick + static_cast<Price>(next);
+        else promoteOverflow();
+    }
+
+    // Next non-empty level strictly worse than `tick` (a live level), or kNoTick if there
+    // is none
+    Price nextWorseTick(Price tick) const {
+        if (inWindow(tick)) {
+            size_t slot = nextWorseSlot(static_cast<size_t>(tick - baseTick));
+            if (slot != LevelBitmap::npos) return baseTick + static_cast<Price>(slot);
+        }
+        return overflow.empty() ? kNoTick : overflowWorseThan(tick);
+    }
+
+    // Read-only access to a live level
+    const PriceLevel& levelAtTick(Price tick) const {
+        return inWindow(tick) ? levels[tick - baseTick] : overflow.find(tick)->second;
+    }
+
+    // Live levels currently held outside the window
+    size_t overflowCount() const { return overflow.size(); }
+
+    // Empties the ladder, keeping the window (and its allocation) where it is
+    void clear();
+
+    void save(checkpoint::Writer& out) const;
+    bool load(checkpoint::Reader& in);
+
+    // Visits non-empty levels from the best price outwards until fn returns false
+    template <typename Fn>
+    void forEachLevel(Fn&& fn) const {
+        if (empty()) return;
+        for (size_t slot = static_cast<size_t>(best - baseTick); slot != LevelBitmap::npos;
+             slot = nextWorseSlot(slot)) {
+            if (!fn(levels[slot])) return;
+        }
+        if (isBid) {
+            for (auto it = overflow.rbegin(); it != overflow.rend(); ++it) {
+                if (!fn(it->second)) return;
+            }
+        } else {
+            for (const auto& entry : overflow) {
+                if (!fn(entry.second)) return;
+            }
+        }
+    }
+
+private:
+    bool isBid;
+    Price baseTick = 0;
+    Price best = kNoTick;
+    size_t activeLevels = 0;
+    std::pmr::vector<PriceLevel> levels;
+    LevelBitmap occupied;
+    // Live levels outside the window, all worse than every level inside it
+    std::pmr::map<Price, PriceLevel> overflow;
+
+    bool inWindow(Price tick) const { return tick >= baseTick && tick - baseTick < static_cast<Price>(levels.size()); }
+
+    // Next occupied slot strictly worse than `slot`, or LevelBitmap::npos
+    size_t nextWorseSlot(size_t slot) const {
+        return isBid ? occupied.findPrev(slot - 1) : occupied.findNext(slot + 1);
+    }
+
+    PriceLevel& outsideLevel(Price tick);
+    Price overflowWorseThan(Price tick) const;
+    void recenter(Price tick);
+    void promoteOverflow();
+    Price anchoredBase(Price tick, size_t capacity) const;
+    void rebuild(Price newBase, size_t capacity);
+};
+
+#endif
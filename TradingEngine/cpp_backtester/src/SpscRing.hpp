@@ -0,0 +1,121 @@
+#ifndef SPSCRING_HPP
+#define SPSCRING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+
+// Lock-free single-producer/single-consumer ring buffer, the native counterpart of the
+// server's OrderRingBuffer. Capacity is a power of two so wrapping is a mask, and the
+// positions are free-running 64-bit counters (never reset, so full/empty need no spare slot).
+//
+// The producer index and consumer index sit on separate cache lines, and each side keeps a
+// private cached copy of the other's index, so the shared lines only move between cores when
+// a side actually runs out of room or data. Publication is batched: writes are staged
+// locally and become visible to the consumer on publish(), and the consumer releases slots
+// once per consumed block rather than per item.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity) {
+        size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+        buffer = std::make_unique<T[]>(rounded);
+        mask = rounded - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // ─── Producer side ───────────────────────────────────────────────
+
+    // Stages one item. Returns false if the ring is full; staged items are not visible
+    // to the consumer until publish().
+    bool tryWrite(const T& item) {
+        if (writePos - producerCachedHead > mask) {
+            producerCachedHead = head.load(std::memory_order_acquire);
+            if (writePos - producerCachedHead > mask) return false;
+        }
+        buffer[writePos & mask] = item;
+        ++writePos;
+        return true;
+    }
+
+    // Stages one item, waiting while the ring is full. Anything staged is published
+    // before waiting so the consumer can always make progress.
+    void write(const T& item) {
+        int spins = 0;
+        while (!tryWrite(item)) {
+            publish();
+            backoff(spins);
+        }
+    }
+
+    void publish() {
+        tail.store(writePos, std::memory_order_release);
+    }
+
+    // ─── Consumer side ───────────────────────────────────────────────
+
+    // Hands up to maxItems published items to fn as one contiguous span (a block never
+    // wraps, so it may be shorter than what is available), then releases them.
+    // Returns the number of items consumed.
+    template <typename Fn>
+    size_t consume(Fn&& fn, size_t maxItems = SIZE_MAX) {
+        if (readPos == consumerCachedTail) {
+            consumerCachedTail = tail.load(std::memory_order_acquire);
+            if (readPos == consumerCachedTail) return 0;
+        }
+        size_t available = static_cast<size_t>(consumerCachedTail - readPos);
+        size_t offset = static_cast<size_t>(readPos & mask);
+        size_t count = std::min({available, maxItems, capacity() - offset});
+        fn(std::span<const T>(buffer.get() + offset, count));
+        readPos += count;
+        head.store(readPos, std::memory_order_release);
+        return count;
+    }
+
+    bool tryRead(T& out) {
+        return consume([&](std::span<const T> items) { out = items[0]; }, 1) == 1;
+    }
+
+    // Busy-wait step: pause for the first few rounds, then yield so a waiting side
+    // doesn't starve the other when both share a core. The count stops at the yield
+    // threshold, so a side that idles indefinitely never overflows it.
+    static void backoff(int& spins) {
+        if (spins < kPauseRounds) {
+            ++spins;
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+    static constexpr int kPauseRounds = 63;
+
+    // Consumer-owned
+    alignas(kCacheLine) std::atomic<uint64_t> head{0};
+    uint64_t readPos = 0;
+    uint64_t consumerCachedTail = 0;
+
+    // Producer-owned
+    alignas(kCacheLine) std::atomic<uint64_t> tail{0};
+    uint64_t writePos = 0;
+    uint64_t producerCachedHead = 0;
+
+    // Read-only after construction
+    alignas(kCacheLine) std::unique_ptr<T[]> buffer;
+    size_t mask = 0;
+};
+
+#endif
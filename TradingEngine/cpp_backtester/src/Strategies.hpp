@@ -0,0 +1,243 @@
+#ifndef STRATEGIES_HPP
+#define STRATEGIES_HPP
+
+#include "IndicatorCache.hpp"
+#include "PositionLedger.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <tuple>
+
+// Trading strategies as plain types. A runner is a template over the strategy type, and the
+// strategy named on the command line is mapped to its type once, up front (see
+// dispatchCandleStrategy / dispatchOrderbookStrategy), so the per-candle or per-tick loop
+// calls straight into an inlined signal() with no string compares or virtual calls.
+//
+// Candle strategies pick up their indicator columns from an IndicatorCache in prepare()
+// (so configurations that share a column share one copy) and then answer signal(i, close):
+// 1 = buy, -1 = sell, 0 = hold for bar i. Their parameters default to the values the
+// backtester has always used; params(self, fn) calls fn(name, field) for each of them, for
+// parameter sweeps, and valid() rejects combinations that make no sense.
+
+struct SmaCrossover {
+    static constexpr const char* kName = "sma_crossover";
+    size_t fastPeriod = 10;
+    size_t slowPeriod = 30;
+
+    std::span<const double> fast, slow;
+
+    template <typename Self, typename Fn>
+    static void params(Self& self, Fn&& fn) {
+        fn("fast", self.fastPeriod);
+        fn("slow", self.slowPeriod);
+    }
+    bool valid() const { return fastPeriod > 0 && fastPeriod < slowPeriod; }
+
+    void prepare(IndicatorCache& cache) {
+        fast = cache.sma(fastPeriod);
+        slow = cache.sma(slowPeriod);
+    }
+
+    int signal(size_t i, double) const {
+        if (i + 1 < slowPeriod) return 0;
+        // No previous crossover state on the first bar with a full slow window
+        double prevFast = i >= slowPeriod ? fast[i - 1] : 0;
+        double prevSlow = i >= slowPeriod ? slow[i - 1] : 0;
+        int signal = 0;
+        // Golden cross: fast crosses above slow
+        if (prevFast <= prevSlow && fast[i] > slow[i]) signal = 1;
+        // Death cross: fast crosses below slow
+        if (prevFast >= prevSlow && fast[i] < slow[i]) signal = -1;
+        return signal;
+    }
+};
+
+struct RsiMeanReversion {
+    static constexpr const char* kName = "rsi_mean_reversion";
+    size_t period = 14;
+    double oversold = 30;
+    double overbought = 70;
+
+    std::span<const double> rsi;
+
+    template <typename Self, typename Fn>
+    static void params(Self& self, Fn&& fn) {
+        fn("period", self.period);
+        fn("oversold", self.oversold);
+        fn("overbought", self.overbought);
+    }
+    bool valid() const { return period > 0 && oversold < overbought; }
+
+    void prepare(IndicatorCache& cache) { rsi = cache.rsi(period); }
+
+    int signal(size_t i, double) const {
+        if (i < period) return 0;
+        if (rsi[i] < oversold) return 1;    // oversold → buy
+        if (rsi[i] > overbought) return -1; // overbought → sell
+        return 0;
+    }
+};
+
+struct BollingerBreakout {
+    static constexpr const char* kName = "bollinger_breakout";
+    size_t period = 20;
+    double bandWidth = 2.0; // standard deviations either side of the mean
+
+    std::span<const double> mean, stdDev;
+
+    template <typename Self, typename Fn>
+    static void params(Self& self, Fn&& fn) {
+        fn("period", self.period);
+        fn("k", self.bandWidth);
+    }
+    bool valid() const { return period > 0 && bandWidth > 0; }
+
+    void prepare(IndicatorCache& cache) { std::tie(mean, stdDev) = cache.bands(period); }
+
+    int signal(size_t i, double close) const {
+        if (i + 1 < period) return 0;
+        double upperBand = mean[i] + bandWidth * stdDev[i];
+        double lowerBand = mean[i] - bandWidth * stdDev[i];
+        int signal = 0;
+        if (close <= lowerBand) signal = 1;  // touch lower band → buy
+        if (close >= upperBand) signal = -1; // touch upper band → sell
+        return signal;
+    }
+};
+
+struct MacdSignal {
+    static constexpr const char* kName = "macd_signal";
+    size_t fastPeriod = 12;
+    size_t slowPeriod = 26;
+    size_t signalPeriod = 9;
+
+    std::span<const double> line, signalLine;
+
+    template <typename Self, typename Fn>
+    static void params(Self& self, Fn&& fn) {
+        fn("fast", self.fastPeriod);
+        fn("slow", self.slowPeriod);
+        fn("signal", self.signalPeriod);
+    }
+    bool valid() const { return fastPeriod > 0 && fastPeriod < slowPeriod && signalPeriod > 0; }
+
+    void prepare(IndicatorCache& cache) { std::tie(line, signalLine) = cache.macd(fastPeriod, slowPeriod, signalPeriod); }
+
+    int signal(size_t i, double) const {
+        if (i <= slowPeriod) return 0;
+        int signal = 0;
+        // Bullish: MACD crosses above signal
+        if (line[i] > signalLine[i] && line[i] > 0 && signalLine[i - 1] >= line[i] * 0.99) signal = 1;
+        // Bearish: MACD crosses below signal
+        if (line[i] < signalLine[i]) signal = -1;
+        return signal;
+    }
+};
+
+// Calls fn(strategy) with a default-constructed strategy of the named type. Returns false
+// (without calling fn) if the name isn't a candle strategy.
+template <typename Fn>
+bool dispatchCandleStrategy(const std::string& name, Fn&& fn) {
+    if (name == SmaCrossover::kName) {
+        fn(SmaCrossover{});
+        return true;
+    }
+    if (name == RsiMeanReversion::kName) {
+        fn(RsiMeanReversion{});
+        return true;
+    }
+    if (name == BollingerBreakout::kName) {
+        fn(BollingerBreakout{});
+        return true;
+    }
+    if (name == MacdSignal::kName) {
+        fn(MacdSignal{});
+        return true;
+    }
+    return false;
+}
+
+// Order-book strategies trade against the replayed flow. After each batch of tape orders,
+// act() may submit and cancel orders of its own through the PositionLedger, and its PnL is
+// whatever those orders' fills make, marked to mid. `isBuy` and `price` describe the last
+// tape order of the batch, in ticks. Order sizes and position limits are fixed parameters
+// in lots, so they don't move with the size of whatever order happened to come last.
+
+// Passive market making: joins the best bid and ask with `quoteLots` and earns the spread
+// when both sides fill. A quote that is still at the touch keeps its queue place; one the
+// touch has moved away from is pulled and re-posted. A side whose fill could take the
+// position past `maxPositionLots` either way is not quoted.
+struct SpreadArbitrage {
+    static constexpr const char* kName = "spread_arbitrage";
+    Qty quoteLots = 1000000;
+    Qty maxPositionLots = 5000000;
+
+    uint64_t bidId = 0, askId = 0;
+    Price bidPrice = 0, askPrice = 0;
+
+    template <typename Book>
+    void act(Book& ob, PositionLedger& ledger, bool, Price) {
+        const Price bestBid = ob.bestBidTicks(), bestAsk = ob.bestAskTicks();
+        const bool canQuote = bestBid != PriceLadder::kNoTick && bestAsk != PriceLadder::kNoTick && quoteLots > 0;
+        requote(ob, ledger, true, canQuote && ledger.position() + quoteLots <= maxPositionLots, bestBid, bidId,
+                bidPrice);
+        requote(ob, ledger, false, canQuote && ledger.position() - quoteLots >= -maxPositionLots, bestAsk, askId,
+                askPrice);
+    }
+
+private:
+    template <typename Book>
+    void requote(Book& ob, PositionLedger& ledger, bool isBuy, bool wanted, Price touch, uint64_t& id, Price& at) {
+        if (ledger.working(id)) {
+            if (wanted && at == touch) return;
+            ledger.cancel(ob, id);
+        }
+        id = wanted ? ledger.submit(ob, isBuy, touch, quoteLots) : 0;
+        at = touch;
+    }
+};
+
+// Trades with the flow: after buying flow it aims to be long `positionLots`, after selling
+// flow as short, crossing the spread for the difference. The order is limited to
+// buyThreshold above (sellThreshold below) the last tape price as a fraction of it, and
+// whatever doesn't fill at once is cancelled.
+struct Momentum {
+    static constexpr const char* kName = "momentum";
+    double buyThreshold = 0.0001;
+    double sellThreshold = 0.0001;
+    Qty positionLots = 1000000;
+
+    template <typename Book>
+    void act(Book& ob, PositionLedger& ledger, bool isBuy, Price price) {
+        const Qty order = (isBuy ? positionLots : -positionLots) - ledger.position();
+        if (order == 0) return;
+        const bool buy = order > 0;
+        const double slippage = static_cast<double>(price) * (buy ? buyThreshold : sellThreshold);
+        const Price limit = buy ? price + std::llround(slippage) : price - std::llround(slippage);
+        ledger.cancel(ob, ledger.submit(ob, buy, limit, buy ? order : -order)); // immediate-or-cancel
+    }
+};
+
+// spread_arbitrage by name; anything else runs momentum. `aggression` scales the default
+// sizes and limits once, up front.
+template <typename Fn>
+void dispatchOrderbookStrategy(const std::string& name, double aggression, double buyThreshold, double sellThreshold,
+                               Fn&& fn) {
+    auto scaled = [aggression](Qty lots) {
+        return static_cast<Qty>(std::llround(static_cast<double>(lots) * aggression));
+    };
+    if (name == SpreadArbitrage::kName) {
+        SpreadArbitrage strategy;
+        strategy.quoteLots = scaled(strategy.quoteLots);
+        strategy.maxPositionLots = scaled(strategy.maxPositionLots);
+        fn(strategy);
+    } else {
+        Momentum strategy{buyThreshold, sellThreshold};
+        strategy.positionLots = scaled(strategy.positionLots);
+        fn(strategy);
+    }
+}
+
+#endif
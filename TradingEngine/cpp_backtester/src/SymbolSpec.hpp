@@ -0,0 +1,33 @@
+#ifndef SYMBOLSPEC_HPP
+#define SYMBOLSPEC_HPP
+
+#include <string>
+#include <cstdint>
+#include <cmath>
+
+// Fixed-point representation used inside the matcher. Prices are whole ticks and
+// quantities whole lots, so level lookup and fill arithmetic are exact integer ops and
+// a filled order reaches exactly zero instead of leaving floating-point dust.
+using Price = int64_t;
+using Qty = int64_t;
+
+// Per-symbol scales. Doubles are converted to ticks/lots only at the edges of the engine
+// (CSV parsing, FlatBuffers requests, reports and snapshots).
+struct SymbolSpec {
+    std::string symbol;
+    double tickSize; // e.g. 0.01 USD
+    double lotSize;  // e.g. 1e-8 BTC
+
+    Price toTicks(double price) const { return std::llround(price / tickSize); }
+    Qty toLots(double qty) const { return std::llround(qty / lotSize); }
+    double toPrice(Price ticks) const { return ticks * tickSize; }
+    double toQty(Qty lots) const { return lots * lotSize; }
+};
+
+// Scales for the Gemini pairs we backtest; anything else gets cent ticks and satoshi lots
+inline SymbolSpec symbolSpecFor(const std::string& symbol) {
+    if (symbol == "SOLUSD") return {symbol, 0.001, 1e-8};
+    return {symbol, 0.01, 1e-8};
+}
+
+#endif
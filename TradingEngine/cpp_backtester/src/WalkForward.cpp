@@ -0,0 +1,35 @@
+#include "WalkForward.hpp"
+#include <algorithm>
+#include <fstream>
+
+std::vector<WalkForwardFold> planFolds(size_t bars, const WalkForwardSpec& spec) {
+    std::vector<WalkForwardFold> folds;
+    if (spec.train == 0 || spec.test == 0) return folds;
+    const size_t step = spec.step > 0 ? spec.step : spec.test;
+    for (size_t begin = 0; begin + spec.train < bars; begin += step) {
+        WalkForwardFold fold;
+        fold.trainBegin = begin;
+        fold.testBegin = begin + spec.train;
+        fold.testEnd = std::min(bars, fold.testBegin + spec.test);
+        folds.push_back(fold);
+    }
+    return folds;
+}
+
+bool WalkForwardReport::writeCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+    out << "fold,train_begin,test_begin,test_end,strategy";
+    for (const std::string& name : paramNames) out << ',' << name;
+    out << ",aggression,is_trades,is_pnl,is_sharpe,oos_trades,oos_win_rate,oos_pnl,oos_max_drawdown,oos_sharpe\n";
+    for (size_t f = 0; f < folds.size(); ++f) {
+        const WalkForwardFold& fold = folds[f];
+        out << f + 1 << ',' << fold.trainBegin << ',' << fold.testBegin << ',' << fold.testEnd << ',' << strategy;
+        for (double value : fold.params) out << ',' << value;
+        out << ',' << fold.aggression << ',' << fold.inSample.totalTrades << ',' << fold.inSample.totalPnL << ','
+            << fold.inSample.sharpeRatio << ',' << fold.outOfSample.totalTrades << ','
+            << fold.outOfSample.winRate() << ',' << fold.outOfSample.totalPnL << ','
+            << fold.outOfSample.maxDrawdown << ',' << fold.outOfSample.sharpeRatio << '\n';
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,127 @@
+#ifndef WALKFORWARD_HPP
+#define WALKFORWARD_HPP
+
+#include "CandleBacktest.hpp"
+#include "CandleSeries.hpp"
+#include "IndicatorCache.hpp"
+#include "Parallel.hpp"
+#include "ParameterSweep.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Walk-forward optimization: the series is cut into rolling folds, each a train window
+// followed by the test window right after it. For every fold the parameter grid is
+// optimized on the train window (by rankedAbove), and the winning configuration is then
+// traded on the unseen test window; stitching the test windows together gives an
+// out-of-sample equity curve.
+//
+// All folds share one IndicatorCache over the whole series. The kernels are causal, so a
+// column's value at bar i is the same whichever window is looking at it: every fold starts
+// with its indicators already warmed up, and overlapping train windows reuse the same
+// columns instead of recomputing them. The optimization jobs of all folds go into one
+// parallel pass.
+
+struct WalkForwardSpec {
+    size_t train = 0; // bars per train window
+    size_t test = 0;  // bars per test window
+    size_t step = 0;  // bars between fold starts (0 = test, i.e. back-to-back test windows)
+};
+
+struct WalkForwardFold {
+    size_t trainBegin = 0;
+    size_t testBegin = 0; // = train end
+    size_t testEnd = 0;
+    std::vector<double> params; // chosen on the train window, in paramNames order
+    double aggression = 1.0;
+    BacktestStats inSample;
+    BacktestStats outOfSample;
+};
+
+struct WalkForwardReport {
+    std::string strategy;
+    std::vector<std::string> paramNames;
+    std::vector<WalkForwardFold> folds;
+    BacktestStats outOfSample; // all test windows stitched in order
+    size_t runs = 0;           // backtests run, train and test
+    size_t indicatorColumns = 0;
+
+    bool writeCsv(const std::string& path) const;
+};
+
+// Fold windows for a series of `bars` bars; the last test window may be cut short
+std::vector<WalkForwardFold> planFolds(size_t bars, const WalkForwardSpec& spec);
+
+template <typename Strategy>
+bool runWalkForward(const CandleSeries& candles, const ParamGrid& grid, const WalkForwardSpec& spec,
+                    unsigned threads, WalkForwardReport& report, std::string& error) {
+    report = WalkForwardReport{};
+    report.strategy = Strategy::kName;
+    if (spec.train == 0 || spec.test == 0) {
+        error = "train and test windows must be at least one bar";
+        return false;
+    }
+    std::vector<Strategy> configs;
+    if (!expandGrid(grid, configs, report.paramNames, error)) return false;
+    if (configs.empty()) {
+        error = "no valid parameter combinations in the grid";
+        return false;
+    }
+    auto aggressionIt = grid.values.find("aggression");
+    const std::vector<double> aggressions =
+        aggressionIt != grid.values.end() ? aggressionIt->second : std::vector<double>{1.0};
+
+    report.folds = planFolds(candles.size(), spec);
+    if (report.folds.empty()) {
+        error = "series too short for one train + test window";
+        return false;
+    }
+
+    IndicatorCache indicators(candles);
+    for (Strategy& config : configs) config.prepare(indicators);
+    report.indicatorColumns = indicators.columnCount();
+
+    // In-sample: every (fold, configuration, aggression) in one pass
+    const size_t perFold = configs.size() * aggressions.size();
+    std::vector<BacktestStats> trained(report.folds.size() * perFold);
+    parallelFor(trained.size(), threads, [&](size_t job) {
+        const WalkForwardFold& fold = report.folds[job / perFold];
+        size_t candidate = job % perFold;
+        trained[job] = backtestCandles(configs[candidate / aggressions.size()], candles,
+                                       aggressions[candidate % aggressions.size()], fold.trainBegin, fold.testBegin);
+    });
+
+    // Pick each fold's winner (first in grid order on ties) and trade it out of sample
+    std::vector<size_t> chosen(report.folds.size(), 0);
+    parallelFor(report.folds.size(), threads, [&](size_t f) {
+        const BacktestStats* results = &trained[f * perFold];
+        for (size_t c = 1; c < perFold; ++c) {
+            if (rankedAbove(results[c], results[chosen[f]])) chosen[f] = c;
+        }
+        WalkForwardFold& fold = report.folds[f];
+        const Strategy& config = configs[chosen[f] / aggressions.size()];
+        fold.aggression = aggressions[chosen[f] % aggressions.size()];
+        Strategy::params(config, [&](const char*, const auto& field) { fold.params.push_back(double(field)); });
+        fold.inSample = results[chosen[f]];
+        fold.outOfSample = backtestCandles(config, candles, fold.aggression, fold.testBegin, fold.testEnd);
+    });
+
+    // Stitched out-of-sample run: test windows in order, each with its fold's winner
+    CandleBacktest stitched(1.0);
+    size_t stitchedUpTo = 0;
+    for (size_t f = 0; f < report.folds.size(); ++f) {
+        const WalkForwardFold& fold = report.folds[f];
+        // With step < test, test windows overlap; only trade each bar once
+        size_t begin = std::max(fold.testBegin, stitchedUpTo);
+        if (begin >= fold.testEnd) continue;
+        stitched.setAggression(fold.aggression);
+        backtestRange(configs[chosen[f] / aggressions.size()], candles, begin, fold.testEnd, stitched);
+        stitchedUpTo = fold.testEnd;
+    }
+    report.outOfSample = stitched.stats();
+    report.runs = trained.size() + report.folds.size();
+    return true;
+}
+
+#endif
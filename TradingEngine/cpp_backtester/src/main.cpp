@@ -1,4 +1,14 @@
 #include "OrderBook.hpp"
+#include "BookManager.hpp"
+#include "Journal.hpp"
+#include "OrderTape.hpp"
+#include "CandleSeries.hpp"
+#include "Strategies.hpp"
+#include "CandleBacktest.hpp"
+#include "ParameterSweep.hpp"
+#include "WalkForward.hpp"
+#include "MonteCarlo.hpp"
+#include "PositionLedger.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -7,12 +17,17 @@
 #include <cmath>
 #include <numeric>
 #include <vector>
-#include <deque>
 #include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <thread>
 #include <gperftools/profiler.h> // Industry standard C++ Profiler
 #include "schema_generated.h"
 using namespace ExecutionCoach::Sim;
 
+// Default order-book strategy fees: Gemini ActiveTrader's base tier, as a fraction of notional
+constexpr FeeSchedule kDefaultFees{0.0020, 0.0040};
+
 struct PerfMetrics {
     long long totalOrdersProcessed;
     double maxLatencyUs;
@@ -20,196 +35,36 @@ struct PerfMetrics {
     double totalPnL;
 };
 
-struct Candle {
-    long long timestamp;
-    double open, high, low, close, volume;
-};
-
-// ─── Technical Indicator Helpers ────────────────────────────────────────
-double calcSMA(const std::deque<double>& prices, int period) {
-    if ((int)prices.size() < period) return 0.0;
-    double sum = 0;
-    for (int i = prices.size() - period; i < (int)prices.size(); i++)
-        sum += prices[i];
-    return sum / period;
-}
-
-double calcEMA(double prevEma, double price, int period) {
-    double k = 2.0 / (period + 1);
-    return price * k + prevEma * (1.0 - k);
-}
-
-double calcRSI(const std::deque<double>& prices, int period) {
-    if ((int)prices.size() < period + 1) return 50.0; // neutral
-    double gainSum = 0, lossSum = 0;
-    for (int i = prices.size() - period; i < (int)prices.size(); i++) {
-        double change = prices[i] - prices[i - 1];
-        if (change > 0) gainSum += change;
-        else lossSum += -change;
-    }
-    double avgGain = gainSum / period;
-    double avgLoss = lossSum / period;
-    if (avgLoss == 0) return 100.0;
-    double rs = avgGain / avgLoss;
-    return 100.0 - (100.0 / (1.0 + rs));
-}
-
-double calcStdDev(const std::deque<double>& prices, int period) {
-    if ((int)prices.size() < period) return 0.0;
-    double mean = calcSMA(prices, period);
-    double sq_sum = 0;
-    for (int i = prices.size() - period; i < (int)prices.size(); i++) {
-        double diff = prices[i] - mean;
-        sq_sum += diff * diff;
-    }
-    return std::sqrt(sq_sum / period);
-}
-
-// ─── Read Candle CSV ────────────────────────────────────────────────────
-std::vector<Candle> readCandles(const std::string& path) {
-    std::vector<Candle> candles;
-    std::ifstream file(path);
-    if (!file.is_open()) return candles;
-    std::string line;
-    std::getline(file, line); // skip header
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string ts, o, h, l, c, v;
-        std::getline(ss, ts, ',');
-        std::getline(ss, o, ',');
-        std::getline(ss, h, ',');
-        std::getline(ss, l, ',');
-        std::getline(ss, c, ',');
-        std::getline(ss, v, ',');
-        Candle cd;
-        cd.timestamp = std::stoll(ts);
-        cd.open = std::stod(o);
-        cd.high = std::stod(h);
-        cd.low = std::stod(l);
-        cd.close = std::stod(c);
-        cd.volume = std::stod(v);
-        candles.push_back(cd);
-    }
-    return candles;
+// ─── Symbol from data file name ─────────────────────────────────────────
+// data/gemini_<symbol>_orderbook.csv -> "<SYMBOL>", so the book picks up that pair's tick/lot scales
+std::string symbolFromPath(const std::string& path) {
+    size_t start = path.find("gemini_");
+    if (start == std::string::npos) return "BTCUSD";
+    start += 7;
+    size_t end = path.find('_', start);
+    if (end == std::string::npos) return "BTCUSD";
+    std::string symbol = path.substr(start, end - start);
+    std::transform(symbol.begin(), symbol.end(), symbol.begin(), ::toupper);
+    return symbol;
 }
 
 // ─── Candle-Based Strategy Runner ───────────────────────────────────────
-void runCandleStrategy(const std::string& strategyType, const std::vector<Candle>& candles, double aggression) {
+// Runs a prepared candle strategy (see Strategies.hpp) over the series; the strategy type
+// is fixed at compile time, so its signal() inlines into the per-candle loop. Returns the
+// per-trade returns.
+template <typename Strategy>
+std::vector<double> runCandleStrategy(const Strategy& strategy, const CandleSeries& candles, double aggression) {
+    CandleBacktest backtest(aggression);
     std::vector<double> pnlHistory;
-    std::vector<double> pnlReturns;
-    double totalPnL = 0;
-    double peakPnl = 0, maxDrawdown = 0;
-    int winningTrades = 0, totalTrades = 0;
+    pnlHistory.reserve(candles.size());
     double totalLatency = 0;
     double maxLatencyUs = 0;
 
-    // State for indicators
-    std::deque<double> closePrices;
-    double ema12 = 0, ema26 = 0, signalLine = 0;
-    bool ema_initialized = false;
-
-    // Position tracking: 0 = flat, 1 = long, -1 = short
-    int position = 0;
-    double entryPrice = 0;
-
     for (size_t i = 0; i < candles.size(); i++) {
         auto start = std::chrono::high_resolution_clock::now();
-        const Candle& c = candles[i];
-        closePrices.push_back(c.close);
-        if (closePrices.size() > 200) closePrices.pop_front(); // rolling window
-
-        int signal = 0; // 1 = buy, -1 = sell, 0 = hold
-
-        if (strategyType == "sma_crossover") {
-            // SMA 10 / 30 crossover
-            if ((int)closePrices.size() >= 30) {
-                double smaShort = calcSMA(closePrices, 10);
-                double smaLong = calcSMA(closePrices, 30);
-                double prevShort = 0, prevLong = 0;
-                if ((int)closePrices.size() >= 31) {
-                    // Peek back by temporarily removing last
-                    double last = closePrices.back();
-                    closePrices.pop_back();
-                    prevShort = calcSMA(closePrices, 10);
-                    prevLong = calcSMA(closePrices, 30);
-                    closePrices.push_back(last);
-                }
-                // Golden cross: short crosses above long
-                if (prevShort <= prevLong && smaShort > smaLong) signal = 1;
-                // Death cross: short crosses below long
-                if (prevShort >= prevLong && smaShort < smaLong) signal = -1;
-            }
-        } else if (strategyType == "rsi_mean_reversion") {
-            if ((int)closePrices.size() >= 15) {
-                double rsi = calcRSI(closePrices, 14);
-                if (rsi < 30) signal = 1;      // oversold → buy
-                else if (rsi > 70) signal = -1; // overbought → sell
-            }
-        } else if (strategyType == "bollinger_breakout") {
-            int period = 20;
-            if ((int)closePrices.size() >= period) {
-                double sma = calcSMA(closePrices, period);
-                double stddev = calcStdDev(closePrices, period);
-                double upperBand = sma + 2.0 * stddev;
-                double lowerBand = sma - 2.0 * stddev;
-                if (c.close <= lowerBand) signal = 1;   // touch lower band → buy
-                if (c.close >= upperBand) signal = -1;  // touch upper band → sell
-            }
-        } else if (strategyType == "macd_signal") {
-            if (!ema_initialized && closePrices.size() >= 1) {
-                ema12 = c.close;
-                ema26 = c.close;
-                signalLine = 0;
-                ema_initialized = true;
-            } else {
-                ema12 = calcEMA(ema12, c.close, 12);
-                ema26 = calcEMA(ema26, c.close, 26);
-                double macd = ema12 - ema26;
-                double prevSignal = signalLine;
-                signalLine = calcEMA(signalLine, macd, 9);
-                // Bullish: MACD crosses above signal
-                if (macd > signalLine && (ema12 - ema26) > 0 && i > 26) {
-                    double prevMacd = ema12 - ema26; // approximate
-                    if (prevSignal >= macd * 0.99) signal = 1;
-                }
-                // Bearish: MACD crosses below signal
-                if (macd < signalLine && i > 26) {
-                    signal = -1;
-                }
-            }
-        }
-
-        // Execute trades based on signal
-        if (signal == 1 && position <= 0) {
-            // Close short if open
-            if (position == -1) {
-                double pnl = (entryPrice - c.close) * aggression;
-                totalPnL += pnl;
-                pnlReturns.push_back(pnl);
-                totalTrades++;
-                if (pnl > 0) winningTrades++;
-            }
-            // Open long
-            position = 1;
-            entryPrice = c.close;
-        } else if (signal == -1 && position >= 0) {
-            // Close long if open
-            if (position == 1) {
-                double pnl = (c.close - entryPrice) * aggression;
-                totalPnL += pnl;
-                pnlReturns.push_back(pnl);
-                totalTrades++;
-                if (pnl > 0) winningTrades++;
-            }
-            // Open short
-            position = -1;
-            entryPrice = c.close;
-        }
-
-        pnlHistory.push_back(totalPnL);
-        if (totalPnL > peakPnl) peakPnl = totalPnL;
-        double dd = peakPnl - totalPnL;
-        if (dd > maxDrawdown) maxDrawdown = dd;
+        const double close = candles.close[i];
+        backtest.onBar(strategy.signal(i, close), close); // signal: 1 = buy, -1 = sell, 0 = hold
+        pnlHistory.push_back(backtest.pnl());
 
         auto end = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double, std::micro> elapsed = end - start;
@@ -219,38 +74,19 @@ void runCandleStrategy(const std::string& strategyType, const std::vector<Candle
     }
 
     // Close any open position at end
-    if (position == 1) {
-        double pnl = (candles.back().close - entryPrice) * aggression;
-        totalPnL += pnl;
-        pnlReturns.push_back(pnl);
-        totalTrades++;
-        if (pnl > 0) winningTrades++;
-        pnlHistory.back() = totalPnL;
-    } else if (position == -1) {
-        double pnl = (entryPrice - candles.back().close) * aggression;
-        totalPnL += pnl;
-        pnlReturns.push_back(pnl);
-        totalTrades++;
-        if (pnl > 0) winningTrades++;
-        pnlHistory.back() = totalPnL;
-    }
+    if (!candles.empty() && backtest.closeOut(candles.close.back())) pnlHistory.back() = backtest.pnl();
 
+    const BacktestStats stats = backtest.stats();
+    const int totalTrades = stats.totalTrades;
+    const double totalPnL = stats.totalPnL;
+    const double maxDrawdown = stats.maxDrawdown;
+    const double sharpeRatio = stats.sharpeRatio;
     double avgLatency = candles.size() > 0 ? totalLatency / candles.size() : 0;
-    double winRate = totalTrades > 0 ? (double)winningTrades / totalTrades : 0;
-
-    // Sharpe Ratio
-    double sharpeRatio = 0;
-    if (pnlReturns.size() > 1) {
-        double sum = std::accumulate(pnlReturns.begin(), pnlReturns.end(), 0.0);
-        double mean = sum / pnlReturns.size();
-        double sq_sum = std::inner_product(pnlReturns.begin(), pnlReturns.end(), pnlReturns.begin(), 0.0);
-        double stdev = std::sqrt(sq_sum / pnlReturns.size() - mean * mean);
-        if (stdev > 0) sharpeRatio = (mean / stdev) * std::sqrt(252);
-    }
+    double winRate = stats.winRate();
 
     // Console output
     std::cout << "=== Candle Strategy Backtest Complete ===\n";
-    std::cout << "Strategy: " << strategyType << "\n";
+    std::cout << "Strategy: " << Strategy::kName << "\n";
     std::cout << "Candles Processed: " << candles.size() << "\n";
     std::cout << "Total Trades: " << totalTrades << "\n";
     std::cout << "Win Rate: " << (winRate * 100) << "%\n";
@@ -262,7 +98,7 @@ void runCandleStrategy(const std::string& strategyType, const std::vector<Candle
     std::ofstream reportFile("data/backtest_report.json");
     if (reportFile.is_open()) {
         reportFile << "{\n";
-        reportFile << "  \"strategy\": \"" << strategyType << "\",\n";
+        reportFile << "  \"strategy\": \"" << Strategy::kName << "\",\n";
         reportFile << "  \"total_orders\": " << candles.size() << ",\n";
         reportFile << "  \"total_trades\": " << totalTrades << ",\n";
         reportFile << "  \"avg_latency_us\": " << avgLatency << ",\n";
@@ -281,94 +117,98 @@ void runCandleStrategy(const std::string& strategyType, const std::vector<Candle
         reportFile.close();
         std::cout << "Report saved to -> data/backtest_report.json\n";
     }
+    return std::vector<double>(backtest.tradeReturns().begin(), backtest.tradeReturns().end());
 }
 
-// ─── Orderbook-Based Strategy Runner (original) ─────────────────────────
-void runOrderbookStrategy(const std::string& csvPath, const std::string& strategyType,
-                          double aggression, double buyThreshold, double sellThreshold) {
-    std::ifstream file(csvPath);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open backtest data file: " << csvPath << "\n";
-        return;
-    }
-
-    OrderBook ob("BTCUSD");
+// ─── Orderbook-Based Strategy Runner ────────────────────────────────────
+// Replays a preloaded tape through `ob`, which the caller passes in empty (new, or see
+// OrderBook::reset), so repeated runs never touch the CSV again. The
+// strategy acts after every batch of tape orders with orders of its own, and `ledger` (the
+// book's listener) books their fills; PnL is sampled, marked to mid, once per batch.
+// Returns the change in equity over each batch.
+template <typename Strategy>
+std::vector<double> runOrderbookStrategy(const OrderTape& tape, LedgerBook& ob, PositionLedger& ledger,
+                                         Strategy strategy) {
     PerfMetrics metrics = {0, 0.0, 0.0, 0.0};
     double totalLatency = 0.0;
 
-    std::string line;
-    std::getline(file, line); // skip header
-
     std::vector<double> pnlHistory;
     std::vector<double> pnlReturns;
+    pnlHistory.reserve(tape.size() / 10 + 1);
+    pnlReturns.reserve(tape.size() / 10 + 1);
     double peakPnl = 0.0, maxDrawdown = 0.0;
-    int winningTrades = 0, totalTrades = 0;
-
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string sideStr, priceStr, amountStr;
-        std::getline(ss, sideStr, ',');
-        std::getline(ss, priceStr, ',');
-        std::getline(ss, amountStr, ',');
-
-        bool isBuy = (sideStr == "buy");
-        double price = std::stod(priceStr);
-        double size = std::stod(amountStr);
+    ledger.reset();
+
+    // Rows are replayed through processBatch in groups of 10, which is also the strategy's
+    // decision and PnL sampling interval. Per-order latency is the time for the batch, the
+    // strategy's reaction and the mark, divided by the batch size.
+    constexpr size_t kBatchSize = 10;
+    std::vector<OrderRequest> batch;
+    batch.reserve(kBatchSize);
+
+    for (size_t row = 0; row < tape.size();) {
+        batch.clear();
+        for (; batch.size() < kBatchSize && row < tape.size(); ++row) {
+            batch.push_back(tape.request(row));
+        }
+        const OrderRequest& last = batch.back();
 
         auto start = std::chrono::high_resolution_clock::now();
-        ob.processOrder(isBuy, price, size);
+        ob.processBatch(batch);
+        strategy.act(ob, ledger, last.isBuy, last.price);
+        ledger.mark(ob.bestBidTicks(), ob.bestAskTicks());
         auto end = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double, std::micro> elapsed = end - start;
 
-        double latency = elapsed.count();
+        double latency = elapsed.count() / batch.size();
         if (latency > metrics.maxLatencyUs) metrics.maxLatencyUs = latency;
-        totalLatency += latency;
-        metrics.totalOrdersProcessed++;
-
-        if (metrics.totalOrdersProcessed % 10 == 0) {
-            double tick = 0.0;
-            if (strategyType == "spread_arbitrage") {
-                tick = (ob.getBestAsk() - ob.getBestBid()) * size * 0.1 * aggression;
-                if (rand() % 10 > 7) tick = -tick * 0.5;
-            } else {
-                tick = (isBuy ? price * buyThreshold : -price * sellThreshold) * aggression;
-            }
-            pnlReturns.push_back(tick);
-            metrics.totalPnL += tick;
-            pnlHistory.push_back(metrics.totalPnL);
-
-            totalTrades++;
-            if (tick > 0) winningTrades++;
-            if (metrics.totalPnL > peakPnl) peakPnl = metrics.totalPnL;
-            double drawdown = peakPnl - metrics.totalPnL;
-            if (drawdown > maxDrawdown) maxDrawdown = drawdown;
-        }
+        totalLatency += elapsed.count();
+        metrics.totalOrdersProcessed += batch.size();
+
+        double equity = ledger.equity();
+        pnlReturns.push_back(equity - metrics.totalPnL);
+        metrics.totalPnL = equity;
+        pnlHistory.push_back(equity);
+        if (equity > peakPnl) peakPnl = equity;
+        double drawdown = peakPnl - equity;
+        if (drawdown > maxDrawdown) maxDrawdown = drawdown;
     }
 
     if (metrics.totalOrdersProcessed > 0)
         metrics.avgLatencyUs = totalLatency / metrics.totalOrdersProcessed;
 
-    double winRate = (totalTrades > 0) ? (double)winningTrades / totalTrades : 0.0;
-    double sharpeRatio = 0.0;
-    if (pnlReturns.size() > 1) {
-        double sum = std::accumulate(pnlReturns.begin(), pnlReturns.end(), 0.0);
-        double mean = sum / pnlReturns.size();
-        double sq_sum = std::inner_product(pnlReturns.begin(), pnlReturns.end(), pnlReturns.begin(), 0.0);
-        double stdev = std::sqrt(sq_sum / pnlReturns.size() - mean * mean);
-        if (stdev > 0) sharpeRatio = (mean / stdev) * std::sqrt(252);
-    }
+    const PositionLedger::Counters& fills = ledger.stats();
+    double winRate = fills.closingFills > 0 ? (double)fills.winningCloses / fills.closingFills : 0.0;
+    double sharpeRatio = ::sharpeRatio(pnlReturns);
 
     ob.printSnapshot();
     std::cout << "=== Backtest Complete ===\n";
     std::cout << "Total Orders: " << metrics.totalOrdersProcessed << "\n";
+    std::cout << "Strategy Orders: " << fills.ordersSubmitted << " | Fills: " << fills.fills << " ("
+              << fills.makerFills << " maker) | Volume: " << ledger.tradedQty() << "\n";
+    std::cout << "Position: " << ledger.positionQty() << " @ " << ledger.averageEntry() << " | Mark: "
+              << ledger.markPrice() << "\n";
+    std::cout << "Realized PnL: $" << ledger.realizedPnL() << " | Unrealized PnL: $" << ledger.unrealizedPnL()
+              << " | Fees: $" << ledger.fees() << "\n";
     std::cout << "Simulated Strategy PnL: $" << metrics.totalPnL << "\n";
 
     std::ofstream reportFile("data/backtest_report.json");
     if (reportFile.is_open()) {
         reportFile << "{\n";
+        reportFile << "  \"strategy\": \"" << Strategy::kName << "\",\n";
         reportFile << "  \"total_orders\": " << metrics.totalOrdersProcessed << ",\n";
         reportFile << "  \"avg_latency_us\": " << metrics.avgLatencyUs << ",\n";
         reportFile << "  \"max_latency_us\": " << metrics.maxLatencyUs << ",\n";
+        reportFile << "  \"strategy_orders\": " << fills.ordersSubmitted << ",\n";
+        reportFile << "  \"fills\": " << fills.fills << ",\n";
+        reportFile << "  \"maker_fills\": " << fills.makerFills << ",\n";
+        reportFile << "  \"traded_volume\": " << ledger.tradedQty() << ",\n";
+        reportFile << "  \"position\": " << ledger.positionQty() << ",\n";
+        reportFile << "  \"average_entry\": " << ledger.averageEntry() << ",\n";
+        reportFile << "  \"mark_price\": " << ledger.markPrice() << ",\n";
+        reportFile << "  \"realized_pnl\": " << ledger.realizedPnL() << ",\n";
+        reportFile << "  \"unrealized_pnl\": " << ledger.unrealizedPnL() << ",\n";
+        reportFile << "  \"fees\": " << ledger.fees() << ",\n";
         reportFile << "  \"simulated_pnl\": " << metrics.totalPnL << ",\n";
         reportFile << "  \"win_rate\": " << winRate << ",\n";
         reportFile << "  \"max_drawdown\": " << maxDrawdown << ",\n";
@@ -385,7 +225,113 @@ void runOrderbookStrategy(const std::string& csvPath, const std::string& strateg
         reportFile.close();
         std::cout << "Report saved to -> data/backtest_report.json\n";
     }
+    return pnlReturns;
 }
+// ─── Multi-Symbol Replay (sharded books) ────────────────────────────────
+// Replays several order-book CSVs at once through a BookManager, interleaving the tapes
+// row by row as a merged feed would, with each symbol's book matched on its own shard.
+void runMultiSymbolReplay(const std::vector<std::string>& csvPaths, int passes, bool pinCores) {
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    BookManager manager(std::min(csvPaths.size(), cores));
+
+    std::vector<SymbolId> ids;
+    std::vector<OrderTape> tapes;
+    for (const auto& path : csvPaths) {
+        OrderTape tape(symbolSpecFor(symbolFromPath(path)));
+        if (!tape.load(path)) {
+            std::cerr << "Failed to open backtest data file: " << path << "\n";
+            return;
+        }
+        SymbolId id;
+        if (!manager.addSymbol(tape.symbolSpec(), id)) {
+            std::cerr << "Too many symbols: " << path << "\n";
+            return;
+        }
+        ids.push_back(id);
+        tapes.push_back(std::move(tape));
+    }
+
+    size_t longest = 0;
+    for (const auto& tape : tapes) longest = std::max(longest, tape.size());
+
+    manager.start(pinCores);
+    long long totalOrders = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        // Every pass replays the tapes into empty books, as the first one did, so orders
+        // a pass leaves resting don't pile up behind the next
+        if (pass > 0) {
+            manager.drain();
+            manager.resetBooks();
+        }
+        for (size_t row = 0; row < longest; ++row) {
+            for (size_t s = 0; s < tapes.size(); ++s) {
+                if (row < tapes[s].size()) {
+                    manager.submit(ids[s], tapes[s].request(row));
+                    ++totalOrders;
+                }
+            }
+        }
+    }
+    manager.drain();
+    auto end = std::chrono::high_resolution_clock::now();
+    manager.stop();
+    std::chrono::duration<double, std::micro> elapsed = end - start;
+
+    for (SymbolId id : ids) manager.book(id).printSnapshot();
+    std::cout << "=== Multi-Symbol Replay Complete ===\n";
+    std::cout << "Symbols: " << ids.size() << " across " << manager.shardCount() << " shard(s)\n";
+    std::cout << "Total Orders: " << totalOrders << "\n";
+    std::cout << "Throughput: " << (totalOrders / elapsed.count()) << " orders/us\n";
+}
+
+// ─── Journal Record / Replay ────────────────────────────────────────────
+// Runs one pass of an order-book CSV through a journaled book, writing every request and
+// fill to journalPath.
+void recordJournal(const std::string& csvPath, const std::string& journalPath) {
+    OrderTape tape(symbolSpecFor(symbolFromPath(csvPath)));
+    if (!tape.load(csvPath)) {
+        std::cerr << "Failed to open backtest data file: " << csvPath << "\n";
+        return;
+    }
+    JournaledOrderBook ob(tape.symbolSpec(), journalPath);
+    if (!ob.ok()) {
+        std::cerr << "Failed to create journal: " << journalPath << "\n";
+        return;
+    }
+    for (size_t row = 0; row < tape.size(); ++row) {
+        ob.processOrderTicks(tape.isBuy(row), tape.price(row), tape.size(row));
+    }
+    if (!ob.flush()) {
+        std::cerr << "Failed writing journal: " << journalPath << "\n";
+        return;
+    }
+    std::cout << "Journaled " << tape.size() << " orders ("<< ob.writer().lastSequence() << " records) -> "
+              << journalPath << "\n";
+}
+
+// Rebuilds the book from a journal and verifies every fill reproduces exactly
+void runJournalReplay(const std::string& journalPath) {
+    JournalReader journal;
+    if (!journal.open(journalPath)) {
+        std::cerr << "Failed to open journal: " << journalPath << "\n";
+        return;
+    }
+    JournalReplayer replayer(journal);
+    auto start = std::chrono::high_resolution_clock::now();
+    JournalReplayStats stats = replayer.run();
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::micro> elapsed = end - start;
+
+    replayer.printSnapshot();
+    std::cout << "=== Journal Replay Complete ===\n";
+    std::cout << "Symbol: " << replayer.symbolSpec().symbol << " | Records: " << journal.records().size() << "\n";
+    std::cout << "Requests: " << stats.requests << " | Trades matched: " << stats.tradesMatched
+              << " | Mismatches: " << stats.mismatches << "\n";
+    if (stats.truncated) std::cout << "Warning: journal ended in a torn record; replayed the intact prefix\n";
+    std::cout << "Replay time: " << elapsed.count() << " us\n";
+}
+
 void runFlatbufferSimulation(const std::string& binPath) {
     std::ifstream infile(binPath, std::ios::binary | std::ios::ate);
     if (!infile) {
@@ -450,13 +396,254 @@ void runFlatbufferSimulation(const std::string& binPath) {
               << "}\n";
 }
 
+// ─── Parameter Sweep ────────────────────────────────────────────────────
+// Backtests every combination of a candle strategy's parameter grid in one process: the
+// candles are loaded once and shared read-only by all worker threads.
+// Splits the trailing arguments of sweep/walkforward into the parameter grid and options:
+// threads=N always, train=/test=/step= when `windows` is given
+bool parseSweepArgs(const std::vector<std::string>& args, ParamGrid& grid, unsigned& threads,
+                    WalkForwardSpec* windows, std::string& error) {
+    for (const std::string& arg : args) {
+        size_t eq = arg.find('=');
+        std::string name = arg.substr(0, eq);
+        if (eq != std::string::npos && (name == "threads" || (windows && (name == "train" || name == "test" ||
+                                                                          name == "step")))) {
+            size_t value = 0;
+            try {
+                value = std::stoul(arg.substr(eq + 1));
+            } catch (const std::exception&) {
+                error = "bad value for " + name;
+                return false;
+            }
+            if (name == "threads") threads = static_cast<unsigned>(value);
+            else if (name == "train") windows->train = value;
+            else if (name == "test") windows->test = value;
+            else windows->step = value;
+        } else if (!grid.add(arg, error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int runParameterSweep(const std::string& csvPath, const std::string& strategyName,
+                      const std::vector<std::string>& args) {
+    ParamGrid grid;
+    unsigned threads = 0;
+    std::string error;
+    if (!parseSweepArgs(args, grid, threads, nullptr, error)) {
+        std::cerr << "Sweep: " << error << "\n";
+        return 1;
+    }
+
+    CandleSeries candles;
+    if (!candles.load(csvPath) || candles.empty()) {
+        std::cerr << "No candle data found in: " << csvPath << "\n";
+        return 1;
+    }
+
+    SweepTable table;
+    bool ok = false;
+    auto start = std::chrono::steady_clock::now();
+    bool known = dispatchCandleStrategy(strategyName, [&](auto strategy) {
+        ok = runSweep<decltype(strategy)>(candles, grid, threads, table, error);
+    });
+    auto end = std::chrono::steady_clock::now();
+    if (!known) {
+        std::cerr << "Sweep: " << strategyName << " is not a candle strategy\n";
+        return 1;
+    }
+    if (!ok) {
+        std::cerr << "Sweep: " << error << "\n";
+        return 1;
+    }
+    table.rank();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "=== Parameter Sweep Complete ===\n";
+    std::cout << "Strategy: " << table.strategy << " | Candles: " << candles.size() << "\n";
+    std::cout << "Runs: " << table.rows.size() << " on " << workerCount(threads) << " threads in " << seconds * 1e3
+              << " ms (" << table.indicatorColumns << " indicator columns)\n";
+    std::cout << "Top results (by Sharpe ratio):\n";
+    for (size_t r = 0; r < std::min<size_t>(10, table.rows.size()); ++r) {
+        const SweepRow& row = table.rows[r];
+        std::cout << "  " << r + 1 << ".";
+        for (size_t p = 0; p < table.paramNames.size(); ++p) std::cout << " " << table.paramNames[p] << "=" << row.params[p];
+        std::cout << " aggression=" << row.aggression << " | trades " << row.stats.totalTrades << ", PnL $"
+                  << row.stats.totalPnL << ", Sharpe " << row.stats.sharpeRatio << ", max DD $" << row.stats.maxDrawdown
+                  << "\n";
+    }
+    if (table.writeCsv("data/sweep_results.csv")) std::cout << "Results saved to -> data/sweep_results.csv\n";
+    return 0;
+}
+
+// ─── Walk-Forward Optimization ──────────────────────────────────────────
+// Optimizes the grid on rolling train windows and trades each winner on the test window
+// after it, reporting the stitched out-of-sample result.
+int runWalkForwardMode(const std::string& csvPath, const std::string& strategyName,
+                       const std::vector<std::string>& args) {
+    ParamGrid grid;
+    unsigned threads = 0;
+    WalkForwardSpec windows;
+    std::string error;
+    if (!parseSweepArgs(args, grid, threads, &windows, error)) {
+        std::cerr << "Walk-forward: " << error << "\n";
+        return 1;
+    }
+
+    CandleSeries candles;
+    if (!candles.load(csvPath) || candles.empty()) {
+        std::cerr << "No candle data found in: " << csvPath << "\n";
+        return 1;
+    }
+
+    WalkForwardReport report;
+    bool ok = false;
+    auto start = std::chrono::steady_clock::now();
+    bool known = dispatchCandleStrategy(strategyName, [&](auto strategy) {
+        ok = runWalkForward<decltype(strategy)>(candles, grid, windows, threads, report, error);
+    });
+    auto end = std::chrono::steady_clock::now();
+    if (!known) {
+        std::cerr << "Walk-forward: " << strategyName << " is not a candle strategy\n";
+        return 1;
+    }
+    if (!ok) {
+        std::cerr << "Walk-forward: " << error << "\n";
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "=== Walk-Forward Optimization Complete ===\n";
+    std::cout << "Strategy: " << report.strategy << " | Candles: " << candles.size() << " | Folds: "
+              << report.folds.size() << "\n";
+    std::cout << "Runs: " << report.runs << " on " << workerCount(threads) << " threads in " << seconds * 1e3
+              << " ms (" << report.indicatorColumns << " indicator columns)\n";
+    for (size_t f = 0; f < report.folds.size(); ++f) {
+        const WalkForwardFold& fold = report.folds[f];
+        std::cout << "  Fold " << f + 1 << ": train [" << fold.trainBegin << ", " << fold.testBegin << ") test ["
+                  << fold.testBegin << ", " << fold.testEnd << ") |";
+        for (size_t p = 0; p < report.paramNames.size(); ++p) std::cout << " " << report.paramNames[p] << "=" << fold.params[p];
+        std::cout << " aggression=" << fold.aggression << " | IS Sharpe " << fold.inSample.sharpeRatio << " | OOS PnL $"
+                  << fold.outOfSample.totalPnL << ", trades " << fold.outOfSample.totalTrades << "\n";
+    }
+    std::cout << "Out-of-sample Trades: " << report.outOfSample.totalTrades << "\n";
+    std::cout << "Out-of-sample Win Rate: " << (report.outOfSample.winRate() * 100) << "%\n";
+    std::cout << "Out-of-sample PnL: $" << report.outOfSample.totalPnL << "\n";
+    std::cout << "Out-of-sample Sharpe Ratio: " << report.outOfSample.sharpeRatio << "\n";
+    std::cout << "Out-of-sample Max Drawdown: $" << report.outOfSample.maxDrawdown << "\n";
+    if (report.writeCsv("data/walkforward_results.csv")) std::cout << "Folds saved to -> data/walkforward_results.csv\n";
+    return 0;
+}
+
+// ─── Monte Carlo Bootstrap ──────────────────────────────────────────────
+// Backtests the strategy once (writing the usual report), then block-bootstraps its trade
+// returns for a distribution of Sharpe ratio, PnL and drawdown.
+int runMonteCarloMode(const std::string& csvPath, const std::string& strategyName,
+                      const std::vector<std::string>& args) {
+    MonteCarloSpec spec;
+    double aggression = 1.0;
+    FeeSchedule fees = kDefaultFees;
+    for (const std::string& arg : args) {
+        size_t eq = arg.find('=');
+        std::string name = arg.substr(0, eq);
+        if (eq == std::string::npos) {
+            std::cerr << "Monte Carlo: expected name=value, got " << arg << "\n";
+            return 1;
+        }
+        try {
+            std::string value = arg.substr(eq + 1);
+            if (name == "samples") spec.samples = std::stoul(value);
+            else if (name == "block") spec.blockLength = std::stoul(value);
+            else if (name == "seed") spec.seed = std::stoull(value);
+            else if (name == "threads") spec.threads = static_cast<unsigned>(std::stoul(value));
+            else if (name == "aggression") aggression = std::stod(value);
+            else if (name == "maker_fee") fees.maker = std::stod(value);
+            else if (name == "taker_fee") fees.taker = std::stod(value);
+            else {
+                std::cerr << "Monte Carlo: unknown option " << name << "\n";
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Monte Carlo: bad value for " << name << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<double> returns;
+    CandleSeries candles;
+    bool isCandleStrategy = dispatchCandleStrategy(strategyName, [&](auto strategy) {
+        if (!candles.load(csvPath) || candles.empty()) return;
+        IndicatorCache indicators(candles);
+        strategy.prepare(indicators);
+        returns = runCandleStrategy(strategy, candles, aggression);
+    });
+    if (isCandleStrategy && candles.empty()) {
+        std::cerr << "No candle data found in: " << csvPath << "\n";
+        return 1;
+    }
+    if (!isCandleStrategy) {
+        OrderTape tape(symbolSpecFor(symbolFromPath(csvPath)));
+        if (!tape.load(csvPath)) {
+            std::cerr << "Failed to open backtest data file: " << csvPath << "\n";
+            return 1;
+        }
+        PositionLedger ledger(tape.symbolSpec(), fees);
+        LedgerBook ob(tape.symbolSpec(), 1 << 16, LedgerListener{&ledger});
+        dispatchOrderbookStrategy(strategyName, aggression, 0.0001, 0.0001, [&](auto strategy) {
+            returns = runOrderbookStrategy(tape, ob, ledger, strategy);
+        });
+    }
+
+    MonteCarloReport report;
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    if (!bootstrapReturns(returns, spec, report, error)) {
+        std::cerr << "Monte Carlo: " << error << "\n";
+        return 1;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    auto print = [](const char* label, const Distribution& d) {
+        std::cout << label << ": mean " << d.mean << " | 5% " << d.p5 << " | median " << d.p50 << " | 95% " << d.p95
+                  << "\n";
+    };
+    std::cout << "=== Monte Carlo Bootstrap Complete ===\n";
+    std::cout << "Trades: " << report.trades << " | Resamples: " << report.samples << " | Block: "
+              << report.blockLength << " trades | Seed: " << report.seed << "\n";
+    std::cout << "Resampled on " << workerCount(spec.threads) << " threads in " << seconds * 1e3 << " ms\n";
+    std::cout << "Observed Sharpe Ratio: " << report.observedSharpe << "\n";
+    print("Sharpe Ratio", report.sharpe);
+    print("PnL ($)", report.totalPnL);
+    print("Max Drawdown ($)", report.maxDrawdown);
+    std::cout << "Probability of Loss: " << (report.lossProbability * 100) << "%\n";
+    if (report.writeJson("data/montecarlo_report.json", strategyName))
+        std::cout << "Distribution saved to -> data/montecarlo_report.json\n";
+    return 0;
+}
+
 // ─── Main ───────────────────────────────────────────────────────────────
 int main(int argc, char* argv[]) {
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <path_to_csv> [strategy_type] [aggression] [buy_threshold] [sell_threshold]\n";
+        std::cerr << "Usage: " << argv[0] << " <path_to_csv> [strategy_type] [aggression] [buy_threshold] [sell_threshold] [maker_fee] [taker_fee]\n";
+        std::cerr << "       (order-book strategies only fill against a tape with crossing flow, such as\n"
+                  << "        data/gemini_btcusd_flow_orderbook.csv; on a resting depth snapshot such as\n"
+                  << "        data/gemini_btcusd_orderbook.csv they place orders but get no fills)\n";
+        std::cerr << "       " << argv[0] << " <orderbook_csv>,<orderbook_csv>,... [pin]   (multi-symbol sharded replay; pin = one core per shard)\n";
+        std::cerr << "       " << argv[0] << " <candles_csv> sweep <strategy> [name=v1,v2,...|name=start:stop:step ...] [threads=N]\n";
+        std::cerr << "       " << argv[0] << " <candles_csv> walkforward <strategy> train=N test=N [step=N] [name=values ...] [threads=N]\n";
+        std::cerr << "       " << argv[0] << " <csv> montecarlo <strategy> [samples=N] [block=N] [seed=N] [aggression=A] [threads=N]\n";
+        std::cerr << "       " << argv[0] << " <orderbook_csv> record_journal <journal_path>\n";
+        std::cerr << "       " << argv[0] << " <journal_path>.journal   (replay and verify a journal)\n";
         return 1;
     }
 
+    if (std::string(argv[1]).find(".journal") != std::string::npos) {
+        runJournalReplay(argv[1]);
+        return 0;
+    }
+
     if (argc >= 2 && std::string(argv[1]).find(".bin") != std::string::npos) {
         // Flatbuffers Direct Execution Mode
         runFlatbufferSimulation(argv[1]);
@@ -464,10 +651,53 @@ int main(int argc, char* argv[]) {
     }
 
     std::string csvPath = argv[1];
+    if (csvPath.find(',') != std::string::npos) {
+        // Comma-separated order-book CSVs: replay every symbol concurrently on sharded books
+        std::vector<std::string> paths;
+        std::stringstream list(csvPath);
+        std::string path;
+        while (std::getline(list, path, ',')) {
+            if (!path.empty()) paths.push_back(path);
+        }
+        std::cout << "Replaying " << paths.size() << " order books on sharded engines (1,000 passes)...\n";
+        runMultiSymbolReplay(paths, 1000, argc >= 3 && std::string(argv[2]) == "pin");
+        return 0;
+    }
+
     std::string strategyType = (argc >= 3) ? argv[2] : "momentum";
+    if (strategyType == "sweep") {
+        if (argc < 4) {
+            std::cerr << "Usage: " << argv[0] << " <candles_csv> sweep <strategy> [name=values ...] [threads=N]\n";
+            return 1;
+        }
+        return runParameterSweep(csvPath, argv[3], std::vector<std::string>(argv + 4, argv + argc));
+    }
+    if (strategyType == "walkforward") {
+        if (argc < 4) {
+            std::cerr << "Usage: " << argv[0]
+                      << " <candles_csv> walkforward <strategy> train=N test=N [step=N] [name=values ...] [threads=N]\n";
+            return 1;
+        }
+        return runWalkForwardMode(csvPath, argv[3], std::vector<std::string>(argv + 4, argv + argc));
+    }
+    if (strategyType == "montecarlo") {
+        if (argc < 4) {
+            std::cerr << "Usage: " << argv[0]
+                      << " <csv> montecarlo <strategy> [samples=N] [block=N] [seed=N] [aggression=A] [threads=N]\n";
+            return 1;
+        }
+        return runMonteCarloMode(csvPath, argv[3], std::vector<std::string>(argv + 4, argv + argc));
+    }
+    if (strategyType == "record_journal") {
+        recordJournal(csvPath, (argc >= 4) ? argv[3] : "data/backtest.journal");
+        return 0;
+    }
     double aggression = (argc >= 4) ? std::stod(argv[3]) : 1.0;
     double buyThreshold = (argc >= 5) ? std::stod(argv[4]) : 0.0001;
     double sellThreshold = (argc >= 6) ? std::stod(argv[5]) : 0.0001;
+    FeeSchedule fees = kDefaultFees;
+    if (argc >= 7) fees.maker = std::stod(argv[6]);
+    if (argc >= 8) fees.taker = std::stod(argv[7]);
 
     std::cout << "Starting high-performance backtest engine...\n";
     std::cout << "Strategy: " << strategyType << " | Aggression: " << aggression << "\n";
@@ -475,26 +705,55 @@ int main(int argc, char* argv[]) {
     ProfilerStart("backtester.prof");
 
     // Candle-based famous strategies
-    if (strategyType == "sma_crossover" || strategyType == "rsi_mean_reversion" ||
-        strategyType == "bollinger_breakout" || strategyType == "macd_signal") {
-        auto candles = readCandles(csvPath);
-        if (candles.empty()) {
-            std::cerr << "No candle data found in: " << csvPath << "\n";
-            ProfilerStop();
-            return 1;
-        }
+    CandleSeries candles;
+    bool isCandleStrategy = dispatchCandleStrategy(strategyType, [&](auto strategy) {
+        if (!candles.load(csvPath) || candles.empty()) return;
         std::cout << "Loaded " << candles.size() << " candles.\n";
-        
+
         // Loop 1000x to build a dense CPU profile without reading from disk on every iteration
+        IndicatorCache indicators(candles);
+        strategy.prepare(indicators);
         std::cout << "Profiling loop 1,000 times...\n";
         for(int i=0; i<1000; i++) {
-            runCandleStrategy(strategyType, candles, aggression);
+            runCandleStrategy(strategy, candles, aggression);
+        }
+    });
+    if (isCandleStrategy) {
+        if (candles.empty()) {
+            std::cerr << "No candle data found in: " << csvPath << "\n";
+            ProfilerStop();
+            return 1;
         }
     } else {
-        // Original orderbook-based strategies
+        // Original orderbook-based strategies. The CSV is parsed once into a tape, and one
+        // book is reset between runs rather than rebuilt, so the profile measures matching
+        // rather than file I/O, parsing and allocation. Its memory comes from a pool that
+        // keeps what the book frees (a recentered ladder's old window, overflow map nodes,
+        // a rehashed index) for the book's next request of that size, so a run that
+        // regrows the book reuses that memory instead of going back to malloc, and memory
+        // stays flat however many runs there are.
+        OrderTape tape(symbolSpecFor(symbolFromPath(csvPath)));
+        if (!tape.load(csvPath)) {
+            std::cerr << "Failed to open backtest data file: " << csvPath << "\n";
+            ProfilerStop();
+            return 1;
+        }
+        // Blocks up to 16 MB (a full-width ladder window) are pooled rather than passed
+        // straight to the heap
+        std::pmr::unsynchronized_pool_resource bookMemory(std::pmr::pool_options{0, 16 << 20});
+        PositionLedger ledger(tape.symbolSpec(), fees);
+        LedgerBook ob(tape.symbolSpec(), 1 << 16, LedgerListener{&ledger}, &bookMemory);
+
         std::cout << "Profiling loop 1,000 times...\n";
-        for(int i=0; i<1000; i++) {
-            runOrderbookStrategy(csvPath, strategyType, aggression, buyThreshold, sellThreshold);
+        dispatchOrderbookStrategy(strategyType, aggression, buyThreshold, sellThreshold, [&](auto strategy) {
+            for(int i=0; i<1000; i++) {
+                ob.reset();
+                runOrderbookStrategy(tape, ob, ledger, strategy);
+            }
+        });
+        if (ledger.stats().ordersSubmitted > 0 && ledger.stats().fills == 0) {
+            std::cout << "No fills: nothing on this tape crosses the strategy's orders (a resting depth\n"
+                      << "snapshot never does); data/gemini_btcusd_flow_orderbook.csv is a sample tape that trades.\n";
         }
     }
 
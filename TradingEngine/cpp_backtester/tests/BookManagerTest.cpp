@@ -0,0 +1,55 @@
+#include "BookManager.hpp"
+#include "TestHarness.hpp"
+#include <string>
+
+TEST(BookManager, SymbolTableRejectsPastLastId) {
+    SymbolTable table;
+    SymbolId id = 0;
+    for (size_t i = 0; i < SymbolTable::kMaxSymbols; ++i) {
+        REQUIRE(table.intern("S" + std::to_string(i), id));
+        REQUIRE(id == static_cast<SymbolId>(i));
+    }
+    CHECK(!table.intern("one_too_many", id));
+    CHECK(table.size() == SymbolTable::kMaxSymbols);
+    CHECK(!table.lookup("one_too_many", id));
+
+    // Symbols already in the table are still found
+    CHECK(table.intern("S65535", id));
+    CHECK(id == 65535);
+}
+
+// Two passes of the same flow, reset in between, end with the same books as one pass
+TEST(BookManager, ResetBooksBetweenPasses) {
+    BookManager manager(2);
+    SymbolId btc = 0, eth = 0;
+    REQUIRE(manager.addSymbol(SymbolSpec{"BTCUSD", 0.01, 1e-8}, btc));
+    REQUIRE(manager.addSymbol(SymbolSpec{"ETHUSD", 0.01, 1e-8}, eth));
+    manager.start();
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass > 0) {
+            manager.drain();
+            manager.resetBooks();
+        }
+        for (Price tick = 0; tick < 20; ++tick) {
+            manager.submit(btc, OrderRequest{10000 - tick, 5, true});
+            manager.submit(eth, OrderRequest{20000 + tick, 7, false});
+        }
+        manager.submit(btc, OrderRequest{9995, 12, false});
+    }
+    manager.drain();
+    manager.stop();
+
+    const OrderBook& btcBook = manager.book(btc);
+    // The sell takes 100.00, 99.99 and 2 of 99.98; without the reset 99.98 would hold 6
+    CHECK(btcBook.bestBidTicks() == 9998);
+    REQUIRE(!btcBook.bidDepth().empty());
+    CHECK(btcBook.bidDepth()[0].size == 3);
+    size_t btcLevels = 0;
+    btcBook.forEachLevel(true, [&](Price, Qty) {
+        ++btcLevels;
+        return true;
+    });
+    CHECK(btcLevels == 18);
+    CHECK(manager.book(eth).bestAskTicks() == 20000);
+    CHECK(manager.book(eth).askDepth()[0].size == 7);
+}
@@ -0,0 +1,89 @@
+#include "OrderBook.hpp"
+#include "OrderIdIndex.hpp"
+#include "TestHarness.hpp"
+#include <vector>
+
+namespace {
+
+const SymbolSpec kSpec{"BTCUSD", 0.01, 1e-8};
+
+struct TradeRecorder : NullBookListener {
+    std::vector<Trade>* trades;
+
+    void onTrade(const Trade& trade) { trades->push_back(trade); }
+};
+
+} // namespace
+
+TEST(CancelAmend, CancelTakesOutOnlyThatOrder) {
+    std::vector<Trade> trades;
+    BasicOrderBook<TradeRecorder> book(kSpec, 64, TradeRecorder{{}, &trades});
+    uint64_t first = book.processOrderTicks(false, 10000, 10);
+    uint64_t middle = book.processOrderTicks(false, 10000, 20);
+    uint64_t last = book.processOrderTicks(false, 10000, 30);
+
+    CHECK(book.cancelOrder(middle));
+    CHECK(!book.cancelOrder(middle));
+    CHECK(!book.cancelOrder(12345));
+    REQUIRE(book.askDepth().size() == 1);
+    CHECK(book.askDepth()[0].size == 40);
+
+    // The rest of the queue still fills in time priority
+    book.processOrderTicks(true, 10000, 40);
+    REQUIRE(trades.size() == 2);
+    CHECK(trades[0].restingId == first);
+    CHECK(trades[1].restingId == last);
+    CHECK(!book.cancelOrder(first)); // filled, so no longer known
+    CHECK(book.bestAskTicks() == PriceLadder::kNoTick);
+}
+
+TEST(CancelAmend, AmendKeepsPriorityOnlyWhenShrinking) {
+    std::vector<Trade> trades;
+    BasicOrderBook<TradeRecorder> book(kSpec, 64, TradeRecorder{{}, &trades});
+    uint64_t first = book.processOrderTicks(false, 10000, 10);
+    uint64_t second = book.processOrderTicks(false, 10000, 10);
+    CHECK(book.amendOrderTicks(first, 10000, 5)); // still ahead of `second`
+    book.processOrderTicks(true, 10000, 5);
+    REQUIRE(trades.size() == 1);
+    CHECK(trades[0].restingId == first);
+
+    trades.clear();
+    uint64_t third = book.processOrderTicks(false, 10000, 10);
+    CHECK(book.amendOrderTicks(second, 10000, 20)); // growing goes to the back
+    book.processOrderTicks(true, 10000, 10);
+    REQUIRE(trades.size() == 1);
+    CHECK(trades[0].restingId == third);
+}
+
+// A price change resubmits under the same id and may trade straight away
+TEST(CancelAmend, AmendAcrossTheSpreadMatches) {
+    std::vector<Trade> trades;
+    BasicOrderBook<TradeRecorder> book(kSpec, 64, TradeRecorder{{}, &trades});
+    uint64_t bid = book.processOrderTicks(true, 9900, 10);
+    uint64_t ask = book.processOrderTicks(false, 10000, 4);
+    CHECK(book.amendOrderTicks(bid, 10000, 10));
+    REQUIRE(trades.size() == 1);
+    CHECK(trades[0].aggressorId == bid);
+    CHECK(trades[0].restingId == ask);
+    CHECK(trades[0].size == 4);
+    CHECK(book.bestBidTicks() == 10000);
+    REQUIRE(book.bidDepth().size() == 1);
+    CHECK(book.bidDepth()[0].size == 6);
+
+    CHECK(book.amendOrderTicks(bid, 10000, 0)); // zero size cancels
+    CHECK(book.bestBidTicks() == PriceLadder::kNoTick);
+    CHECK(!book.amendOrderTicks(bid, 10000, 5));
+}
+
+// Erasing from the middle of long probe runs must leave every other id findable
+TEST(CancelAmend, IndexEraseKeepsProbeRunsIntact) {
+    OrderIdIndex index(8);
+    for (uint64_t id = 1; id <= 2000; ++id) index.insert(id, static_cast<NodeId>(id * 3));
+    for (uint64_t id = 1; id <= 2000; id += 3) index.erase(id);
+    CHECK(index.size() == 2000 - 667);
+    for (uint64_t id = 1; id <= 2000; ++id) {
+        CHECK(index.find(id) == (id % 3 == 1 ? kNullNode : static_cast<NodeId>(id * 3)));
+    }
+    index.erase(999999); // unknown ids are ignored
+    CHECK(index.size() == 2000 - 667);
+}
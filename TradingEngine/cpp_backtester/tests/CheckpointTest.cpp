@@ -0,0 +1,160 @@
+#include "Crc32c.hpp"
+#include "OrderBook.hpp"
+#include "TestHarness.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct TradeLog {
+    std::vector<Trade>* trades;
+
+    void onTrade(const Trade& trade) { trades->push_back(trade); }
+    void onAdd(uint64_t, bool, Price, Qty) {}
+    void onCancel(uint64_t, bool, Price, Qty) {}
+    void onLevelChange(bool, Price, Qty) {}
+};
+
+using LoggedBook = BasicOrderBook<TradeLog>;
+
+const SymbolSpec kSpec{"BTCUSD", 0.01, 1e-8};
+
+// Random orders, cancels and amends around a drifting mid, with a few far from the touch
+void drive(LoggedBook& book, std::mt19937_64& rng, int steps) {
+    Price mid = 6000000;
+    for (int step = 0; step < steps; ++step) {
+        Price price = mid + static_cast<Price>(rng() % 200) - 100;
+        if (rng() % 50 == 0) price = 1 + static_cast<Price>(rng() % 20000000);
+        Qty qty = 1 + static_cast<Qty>(rng() % 50);
+        uint64_t target = 1 + rng() % book.upcomingOrderId();
+        switch (rng() % 4) {
+        case 0: book.cancelOrder(target); break;
+        case 1: book.amendOrderTicks(target, price, qty); break;
+        default: book.processOrderTicks(rng() & 1, price, qty); break;
+        }
+        mid += static_cast<Price>(rng() % 3) - 1;
+    }
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+} // namespace
+
+// A restored book must be the same book: it saves to identical bytes, and the same orders
+// sent to it and to the original produce the same fills
+TEST(Checkpoint, RestoredBookBehavesIdentically) {
+    testing::TempPath first("first.ckpt"), second("second.ckpt");
+    std::vector<Trade> originalTrades, restoredTrades;
+    LoggedBook original(kSpec, 4096, TradeLog{&originalTrades});
+    LoggedBook restored(kSpec, 4096, TradeLog{&restoredTrades});
+
+    std::mt19937_64 warmup(11);
+    drive(original, warmup, 20000);
+    REQUIRE(original.saveCheckpoint(first.str()));
+    REQUIRE(restored.loadCheckpoint(first.str()));
+    REQUIRE(restored.saveCheckpoint(second.str()));
+    CHECK(readFile(first.str()) == readFile(second.str()));
+
+    CHECK(restored.upcomingOrderId() == original.upcomingOrderId());
+    CHECK(restored.bestBidTicks() == original.bestBidTicks());
+    CHECK(restored.bestAskTicks() == original.bestAskTicks());
+    auto sameDepth = [](std::span<const DepthLevel> a, std::span<const DepthLevel> b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                          [](const DepthLevel& x, const DepthLevel& y) { return x.price == y.price && x.size == y.size; });
+    };
+    CHECK(sameDepth(restored.bidDepth(), original.bidDepth()));
+    CHECK(sameDepth(restored.askDepth(), original.askDepth()));
+
+    originalTrades.clear();
+    std::mt19937_64 a(12), b(12);
+    drive(original, a, 20000);
+    drive(restored, b, 20000);
+    REQUIRE(originalTrades.size() == restoredTrades.size());
+    CHECK(!originalTrades.empty());
+    for (size_t i = 0; i < originalTrades.size(); ++i) {
+        CHECK(originalTrades[i].aggressorId == restoredTrades[i].aggressorId);
+        CHECK(originalTrades[i].restingId == restoredTrades[i].restingId);
+        CHECK(originalTrades[i].price == restoredTrades[i].price);
+        CHECK(originalTrades[i].size == restoredTrades[i].size);
+    }
+}
+
+TEST(Checkpoint, RejectsOtherSymbolAndLeavesBookUntouched) {
+    testing::TempPath path("symbol.ckpt");
+    OrderBook source(kSpec, 64);
+    source.processOrderTicks(true, 100, 5);
+    REQUIRE(source.saveCheckpoint(path.str()));
+
+    OrderBook other(SymbolSpec{"ETHUSD", 0.01, 1e-8}, 64);
+    other.processOrderTicks(false, 200, 5);
+    CHECK(!other.loadCheckpoint(path.str()));
+    CHECK(other.bestAskTicks() == 200);
+    CHECK(other.bestBidTicks() == PriceLadder::kNoTick);
+}
+
+TEST(Checkpoint, RejectsTruncatedFile) {
+    testing::TempPath path("truncated.ckpt");
+    OrderBook source(kSpec, 64);
+    for (Price tick = 100; tick < 110; ++tick) source.processOrderTicks(true, tick, 5);
+    REQUIRE(source.saveCheckpoint(path.str()));
+    std::string bytes = readFile(path.str());
+    std::ofstream(path.str(), std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size() / 2);
+
+    OrderBook target(kSpec, 64);
+    CHECK(!target.loadCheckpoint(path.str()));
+    CHECK(target.bestBidTicks() == PriceLadder::kNoTick);
+}
+
+TEST(Checkpoint, RejectsDamagedPayload) {
+    testing::TempPath path("damaged.ckpt");
+    OrderBook source(kSpec, 64);
+    for (Price tick = 100; tick < 110; ++tick) source.processOrderTicks(true, tick, 5);
+    REQUIRE(source.saveCheckpoint(path.str()));
+    std::string bytes = readFile(path.str());
+    bytes[bytes.size() / 2] ^= 0x10;
+    std::ofstream(path.str(), std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+
+    OrderBook target(kSpec, 64);
+    CHECK(!target.loadCheckpoint(path.str()));
+}
+
+// A file with a valid checksum but links that point outside the slab (as a buggy writer
+// or a hand edit could produce) must not be restored either
+TEST(Checkpoint, RejectsOutOfRangeLinks) {
+    testing::TempPath path("links.ckpt");
+    OrderBook source(kSpec, 64);
+    source.processOrderTicks(true, 100, 5);
+    source.processOrderTicks(true, 100, 777777);
+    source.processOrderTicks(true, 100, 6);
+    REQUIRE(source.saveCheckpoint(path.str()));
+    const std::string original = readFile(path.str());
+
+    // Locate the level's one block by its price, links and slot counts
+    const OrderBlockInfo probe{100, kNullNode, kNullNode, 0, 3, 3, true};
+    const size_t at = original.find(std::string(reinterpret_cast<const char*>(&probe), 22));
+    REQUIRE(at != std::string::npos);
+
+    auto forge = [&](size_t field, auto value) {
+        std::string bytes = original;
+        std::memcpy(bytes.data() + at + field, &value, sizeof(value));
+        const size_t payload = bytes.size() - 8;
+        uint32_t crc = crc32c(bytes.data(), payload);
+        std::memcpy(bytes.data() + payload, &crc, sizeof(crc));
+        std::ofstream(path.str(), std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+        OrderBook target(kSpec, 64);
+        return target.loadCheckpoint(path.str());
+    };
+    CHECK(forge(offsetof(OrderBlockInfo, prev), kNullNode));      // unchanged: the original links load
+    CHECK(!forge(offsetof(OrderBlockInfo, next), NodeId(40000))); // past the slab
+    CHECK(!forge(offsetof(OrderBlockInfo, prev), kNullNode - 1));
+    CHECK(!forge(offsetof(OrderBlockInfo, end), uint16_t(kBlockOrders + 1))); // slots past the block
+}
@@ -0,0 +1,96 @@
+#include "ColumnFile.hpp"
+#include "Crc32c.hpp"
+#include "TestHarness.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+const columns::Type kSchema[] = {columns::Type::Int64, columns::Type::UInt8};
+const double kScale[2] = {0.01, 1e-8};
+const columns::SourceStamp kSource{1234, 5678};
+
+struct Columns {
+    std::vector<int64_t> prices;
+    std::vector<uint8_t> sides;
+};
+
+Columns sample() {
+    Columns c;
+    for (int64_t i = 0; i < 1000; ++i) {
+        c.prices.push_back(6000000 + i * 7);
+        c.sides.push_back(static_cast<uint8_t>(i & 1));
+    }
+    return c;
+}
+
+bool writeSample(const std::string& path, const Columns& c) {
+    const columns::ColumnData data[] = {{columns::Type::Int64, c.prices.data()}, {columns::Type::UInt8, c.sides.data()}};
+    return columns::write(path, columns::Kind::OrderTape, kSource, kScale, c.prices.size(), data);
+}
+
+bool openSample(const std::string& path, columns::Reader& reader) {
+    return reader.open(path, columns::Kind::OrderTape, kSchema, kSource, kScale);
+}
+
+std::vector<char> readAll(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), {});
+}
+
+void writeAll(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+} // namespace
+
+TEST(ColumnFile, RoundTripLeavesNoTemporary) {
+    testing::TempPath path("roundtrip.cols");
+    const Columns c = sample();
+    REQUIRE(writeSample(path.str(), c));
+
+    columns::Reader reader;
+    REQUIRE(openSample(path.str(), reader));
+    REQUIRE(reader.rows() == c.prices.size());
+    CHECK(reader.column<int64_t>(0)[999] == c.prices[999]);
+    CHECK(reader.column<uint8_t>(1)[3] == 1);
+
+    // The temporary was renamed into place; nothing else beside the cache starts with its name
+    const std::filesystem::path file(path.str());
+    for (const auto& entry : std::filesystem::directory_iterator(file.parent_path())) {
+        const std::string name = entry.path().filename().string();
+        CHECK(name == file.filename().string() || name.rfind(file.filename().string(), 0) != 0);
+    }
+}
+
+TEST(ColumnFile, RejectsDamagedColumn) {
+    testing::TempPath path("damaged.cols");
+    REQUIRE(writeSample(path.str(), sample()));
+    std::vector<char> bytes = readAll(path.str());
+    bytes[bytes.size() - 100] ^= 0x10; // inside the last column
+    writeAll(path.str(), bytes);
+
+    columns::Reader reader;
+    CHECK(!openSample(path.str(), reader));
+}
+
+// A row count large enough that rows * 8 wraps to the real byte count, with the header
+// checksum recomputed to match, must still be refused
+TEST(ColumnFile, RejectsWrappingRowCount) {
+    testing::TempPath path("wrapping.cols");
+    REQUIRE(writeSample(path.str(), sample()));
+    std::vector<char> bytes = readAll(path.str());
+    columns::Header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.rowCount += uint64_t{1} << 61;
+    header.crc = 0;
+    const size_t directoryBytes = header.columnCount * sizeof(columns::ColumnEntry);
+    header.crc = crc32c(bytes.data() + sizeof(header), directoryBytes, crc32c(&header, sizeof(header)));
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    writeAll(path.str(), bytes);
+
+    columns::Reader reader;
+    CHECK(!openSample(path.str(), reader));
+}
@@ -0,0 +1,30 @@
+#include "CounterRng.hpp"
+#include "TestHarness.hpp"
+
+// Known-answer vectors for Philox4x32-10 from the Random123 distribution (kat_vectors)
+TEST(CounterRng, PhiloxKnownAnswers) {
+    philox::Counter zero = philox::philox4x32({0, 0, 0, 0}, {0, 0});
+    CHECK((zero == philox::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+
+    philox::Counter ones = philox::philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff});
+    CHECK((ones == philox::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+
+    philox::Counter pi = philox::philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0});
+    CHECK((pi == philox::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(CounterRng, StreamMatchesRandomAccess) {
+    CounterRng rng(7, 3);
+    for (uint64_t k = 0; k < 16; ++k) CHECK(rng.next() == CounterRng::at(7, 3, k));
+    CHECK(CounterRng::at(7, 3, 0) != CounterRng::at(7, 4, 0));
+    CHECK(CounterRng::at(7, 3, 0) != CounterRng::at(8, 3, 0));
+}
+
+TEST(CounterRng, BoundedValuesStayInRange) {
+    CounterRng rng(1, 0);
+    for (int i = 0; i < 10000; ++i) {
+        CHECK(rng.below(7) < 7);
+        double u = rng.uniform();
+        CHECK(u >= 0.0 && u < 1.0);
+    }
+}
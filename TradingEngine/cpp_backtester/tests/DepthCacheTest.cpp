@@ -0,0 +1,76 @@
+#include "OrderBook.hpp"
+#include "ReferenceBook.hpp"
+#include "TestHarness.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+const SymbolSpec kSpec{"BTCUSD", 0.01, 1e-8};
+
+bool sameRows(std::span<const DepthLevel> depth, const std::vector<std::pair<Price, Qty>>& levels) {
+    if (depth.size() != std::min(levels.size(), OrderBook::kDepthLevels)) return false;
+    for (size_t i = 0; i < depth.size(); ++i) {
+        if (depth[i].price != levels[i].first || depth[i].size != levels[i].second) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// Fifteen bid levels, one order each at 10000, 9999, ..., 9986
+TEST(DepthCache, LevelsSlideInAndOut) {
+    OrderBook book(kSpec, 64);
+    std::vector<uint64_t> ids;
+    for (Price tick = 10000; tick > 9985; --tick) ids.push_back(book.processOrderTicks(true, tick, 10000 - tick + 1));
+    std::span<const DepthLevel> depth = book.bidDepth();
+    const DepthLevel* rows = depth.data();
+    REQUIRE(depth.size() == OrderBook::kDepthLevels);
+    CHECK(depth[0].price == 10000);
+    CHECK(depth[9].price == 9991);
+
+    // Cancelling the third level pulls the eleventh up from the ladder
+    book.cancelOrder(ids[2]);
+    depth = book.bidDepth();
+    REQUIRE(depth.size() == OrderBook::kDepthLevels);
+    CHECK(depth[2].price == 9997);
+    CHECK(depth[9].price == 9990);
+    CHECK(depth[9].size == 11);
+
+    // A new best level pushes the tenth out
+    book.processOrderTicks(true, 10001, 3);
+    depth = book.bidDepth();
+    CHECK(depth[0].price == 10001);
+    CHECK(depth[9].price == 9991);
+
+    // A size change inside the top N updates its row in place
+    book.processOrderTicks(false, 10000, 1);
+    CHECK(book.bidDepth()[0].size == 2);
+
+    // The view is always over the same cached rows, never a copy
+    CHECK(book.bidDepth().data() == rows);
+}
+
+// Random flow near the touch, so levels keep emptying inside and just below the top N,
+// checked against the full level list of ReferenceBook after every step
+TEST(DepthCache, MatchesReferenceLevels) {
+    std::mt19937_64 rng(11);
+    OrderBook book(kSpec, 1024);
+    ReferenceBook reference;
+    std::vector<uint64_t> ids;
+    for (int step = 0; step < 20000; ++step) {
+        const bool isBuy = rng() & 1;
+        const Price price = 10000 + static_cast<Price>(rng() % 40) - 20;
+        const Qty qty = 1 + static_cast<Qty>(rng() % 20);
+        if (rng() % 3 == 0 && !ids.empty()) {
+            const uint64_t orderId = ids[rng() % ids.size()];
+            REQUIRE(book.cancelOrder(orderId) == reference.cancel(orderId));
+        } else {
+            ids.push_back(book.processOrderTicks(isBuy, price, qty));
+            reference.add(isBuy, price, qty);
+        }
+        REQUIRE(sameRows(book.bidDepth(), reference.bidLevels()));
+        REQUIRE(sameRows(book.askDepth(), reference.askLevels()));
+    }
+}
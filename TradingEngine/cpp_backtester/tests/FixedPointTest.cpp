@@ -0,0 +1,29 @@
+#include "OrderBook.hpp"
+#include "SymbolSpec.hpp"
+#include "TestHarness.hpp"
+
+// Decimal inputs that are not exact in binary still land on the nearest tick and lot
+TEST(FixedPoint, ConversionsRoundToNearest) {
+    const SymbolSpec btc = symbolSpecFor("BTCUSD");
+    CHECK(btc.toTicks(0.1 + 0.2) == 30);
+    CHECK(btc.toTicks(60000.07) == 6000007);
+    CHECK(btc.toTicks(60000.074999) == 6000007);
+    CHECK(btc.toLots(0.1) == 10000000);
+    CHECK(btc.toLots(0.00000001) == 1);
+    CHECK(btc.toTicks(btc.toPrice(6000007)) == 6000007);
+
+    const SymbolSpec sol = symbolSpecFor("SOLUSD");
+    CHECK(sol.toTicks(142.517) == 142517);
+}
+
+// Fills of 0.1 + 0.2 against 0.3 leave nothing resting, where doubles would leave dust
+TEST(FixedPoint, PartialFillsReachExactlyZero) {
+    OrderBook book(symbolSpecFor("BTCUSD"), 64);
+    book.processOrder(false, 60000.01, 0.1);
+    book.processOrder(false, 60000.01, 0.2);
+    book.processOrder(true, 60000.01, 0.3);
+    CHECK(book.bestAskTicks() == PriceLadder::kNoTick);
+    CHECK(book.bestBidTicks() == PriceLadder::kNoTick);
+    CHECK(book.askDepth().empty());
+    CHECK(book.bidDepth().empty());
+}
@@ -0,0 +1,48 @@
+#include "IndicatorKernels.hpp"
+#include "TestHarness.hpp"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+bool near(double a, double b) { return std::fabs(a - b) < 1e-9; }
+
+} // namespace
+
+// Period 2 over changes +1, -0.5, +1, -0.5, +1, worked out by hand
+TEST(IndicatorKernels, WilderRsi) {
+    const std::vector<double> close{10, 11, 10.5, 11.5, 11, 12};
+    std::vector<double> rsi(close.size());
+    kernels::rsi(close, 2, rsi);
+    CHECK(rsi[0] == 50.0 && rsi[1] == 50.0);
+    CHECK(near(rsi[2], 100.0 - 100.0 / 3.0));  // gain 0.5, loss 0.25
+    CHECK(near(rsi[3], 100.0 - 100.0 / 7.0));  // gain (0.5 + 1) / 2, loss 0.25 / 2
+    CHECK(near(rsi[4], 100.0 - 100.0 / 2.2));  // gain 0.375, loss (0.125 + 0.5) / 2
+    CHECK(near(rsi[5], 100.0 - 100.0 / 5.4));  // gain 0.6875, loss 0.15625
+
+    // No losses at all: 100
+    const std::vector<double> rising{1, 2, 3, 4};
+    std::vector<double> up(rising.size());
+    kernels::rsi(rising, 2, up);
+    CHECK(up[2] == 100.0 && up[3] == 100.0);
+}
+
+// The block-prefix SMA and deviation match a direct rescan of every window
+TEST(IndicatorKernels, WindowedMatchesRescan) {
+    std::vector<double> close(10000);
+    for (size_t i = 0; i < close.size(); ++i) close[i] = 68000.0 + static_cast<double>(i * 7919 % 401) * 0.25;
+    const size_t period = 20;
+    std::vector<double> sma(close.size()), mean(close.size()), stdDev(close.size());
+    kernels::sma(close, period, sma);
+    kernels::rollingStdDev(close, period, mean, stdDev);
+    CHECK(sma[period - 2] == 0.0 && stdDev[period - 2] == 0.0);
+    for (size_t i = period - 1; i < close.size(); ++i) {
+        double sum = 0, sq = 0;
+        for (size_t j = i + 1 - period; j <= i; ++j) sum += close[j];
+        const double m = sum / period;
+        for (size_t j = i + 1 - period; j <= i; ++j) sq += (close[j] - m) * (close[j] - m);
+        CHECK(std::fabs(sma[i] - m) < 1e-8);
+        CHECK(std::fabs(mean[i] - m) < 1e-8);
+        CHECK(std::fabs(stdDev[i] - std::sqrt(sq / period)) < 1e-6);
+    }
+}
@@ -0,0 +1,66 @@
+#include "LevelBitmap.hpp"
+#include "TestHarness.hpp"
+#include <iterator>
+#include <random>
+#include <set>
+
+namespace {
+
+size_t nextIn(const std::set<size_t>& bits, size_t i) {
+    auto it = bits.lower_bound(i);
+    return it == bits.end() ? LevelBitmap::npos : *it;
+}
+
+size_t prevIn(const std::set<size_t>& bits, size_t i) {
+    auto it = bits.upper_bound(i);
+    return it == bits.begin() ? LevelBitmap::npos : *std::prev(it);
+}
+
+} // namespace
+
+TEST(LevelBitmap, EmptyAndEdges) {
+    LevelBitmap bitmap;
+    bitmap.reset(1000); // not a multiple of 64
+    CHECK(bitmap.findNext(0) == LevelBitmap::npos);
+    CHECK(bitmap.findPrev(999) == LevelBitmap::npos);
+
+    bitmap.set(0);
+    bitmap.set(999);
+    CHECK(bitmap.findNext(0) == 0);
+    CHECK(bitmap.findNext(1) == 999);
+    CHECK(bitmap.findNext(1000) == LevelBitmap::npos);
+    CHECK(bitmap.findPrev(998) == 0);
+    CHECK(bitmap.findPrev(5000) == 999); // clamps to the last slot
+    CHECK(bitmap.findPrev(LevelBitmap::npos) == LevelBitmap::npos);
+
+    bitmap.clear(0);
+    bitmap.clear(999);
+    CHECK(bitmap.findNext(0) == LevelBitmap::npos);
+    CHECK(bitmap.findPrev(999) == LevelBitmap::npos);
+}
+
+// Random sets and clears over 2^20 slots, sparse enough that scans cross whole empty
+// level-1 and level-2 words, checked against std::set after every change
+TEST(LevelBitmap, MatchesOrderedSet) {
+    const size_t kBits = 1 << 20;
+    std::mt19937_64 rng(7);
+    LevelBitmap bitmap;
+    bitmap.reset(kBits);
+    std::set<size_t> bits;
+
+    for (int step = 0; step < 20000; ++step) {
+        size_t i = rng() % kBits;
+        if (rng() % 3 == 0 && !bits.empty()) {
+            i = nextIn(bits, i) == LevelBitmap::npos ? *bits.begin() : nextIn(bits, i);
+            bitmap.clear(i);
+            bits.erase(i);
+        } else if (bits.size() < 64) {
+            bitmap.set(i);
+            bits.insert(i);
+        }
+        size_t probe = rng() % kBits;
+        REQUIRE(bitmap.test(probe) == (bits.count(probe) == 1));
+        REQUIRE(bitmap.findNext(probe) == nextIn(bits, probe));
+        REQUIRE(bitmap.findPrev(probe) == prevIn(bits, probe));
+    }
+}
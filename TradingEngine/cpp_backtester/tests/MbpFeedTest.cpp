@@ -0,0 +1,118 @@
+#include "MbpFeed.hpp"
+#include "OrderBook.hpp"
+#include "TestHarness.hpp"
+#include <map>
+#include <random>
+
+namespace {
+
+const SymbolSpec kSpec{"BTCUSD", 0.01, 1e-8};
+
+using FeedBook = BasicOrderBook<MbpFeedListener>;
+
+// A consumer's copy of the book, kept current from the feed the way the MbpFeed comment
+// describes: apply updates in seq order, go stale on a gap, rebuild from the book
+struct MbpCopy {
+    std::map<Price, Qty> bids, asks;
+    uint64_t nextSeq = 1;
+    bool stale = false;
+
+    void drain(MbpFeed& feed) {
+        while (feed.consume([&](std::span<const MbpUpdate> updates) {
+            for (const MbpUpdate& update : updates) apply(update);
+        }) > 0) {
+        }
+    }
+
+    void apply(const MbpUpdate& update) {
+        if (update.seq < nextSeq) return; // already in a rebuilt copy
+        if (update.seq != nextSeq) stale = true;
+        nextSeq = update.seq + 1;
+        if (stale) return;
+        auto& levels = update.isBid ? bids : asks;
+        if (update.totalSize == 0) levels.erase(update.price);
+        else levels[update.price] = update.totalSize;
+    }
+
+    // Resync: the whole book, then carry on after the last seq it already reflects
+    void rebuild(const FeedBook& book, const MbpFeed& feed) {
+        load(book);
+        nextSeq = feed.lastSequence() + 1;
+        stale = false;
+    }
+
+    void load(const FeedBook& book) {
+        bids.clear();
+        asks.clear();
+        book.forEachLevel(true, [&](Price price, Qty size) {
+            bids.emplace(price, size);
+            return true;
+        });
+        book.forEachLevel(false, [&](Price price, Qty size) {
+            asks.emplace(price, size);
+            return true;
+        });
+    }
+
+    bool matches(const FeedBook& book) const {
+        MbpCopy full;
+        full.load(book);
+        return bids == full.bids && asks == full.asks;
+    }
+};
+
+} // namespace
+
+// Every level change gets the next seq, and a consumer that keeps up ends with the whole
+// book, well past the top-N depth views
+TEST(MbpFeed, ConsumerTracksEveryLevel) {
+    MbpFeed feed(1024);
+    FeedBook book(kSpec, 1024, MbpFeedListener{&feed});
+    MbpCopy copy;
+    std::mt19937_64 rng(3);
+    for (int step = 0; step < 5000; ++step) {
+        const bool isBuy = rng() & 1;
+        const Price price = 10000 + (isBuy ? -1 : 1) * static_cast<Price>(rng() % 60);
+        book.processOrderTicks(isBuy, price, 1 + static_cast<Qty>(rng() % 20));
+        feed.publish();
+        copy.drain(feed);
+        REQUIRE(!copy.stale);
+    }
+    CHECK(feed.dropped() == 0);
+    CHECK(copy.nextSeq == feed.lastSequence() + 1);
+    CHECK(copy.bids.size() > OrderBook::kDepthLevels);
+    CHECK(copy.matches(book));
+}
+
+// A consumer that falls a whole ring behind loses updates, sees the gap in seq, and
+// recovers by rebuilding from the book
+TEST(MbpFeed, RingFullDropsAndResyncs) {
+    MbpFeed feed(16);
+    FeedBook book(kSpec, 64, MbpFeedListener{&feed});
+    for (Price tick = 10000; tick < 10020; ++tick) book.processOrderTicks(false, tick, 5); // 20 new levels
+    feed.publish();
+    CHECK(feed.lastSequence() == 20);
+    CHECK(feed.dropped() == 4);
+
+    MbpCopy copy;
+    copy.drain(feed);
+    CHECK(!copy.stale); // seq 1..16 arrived in order; the loss is not visible yet
+    CHECK(copy.asks.size() == 16);
+
+    book.processOrderTicks(true, 10000, 5); // empties 100.00: seq 21
+    feed.publish();
+    copy.drain(feed);
+    CHECK(copy.stale); // expected 17
+    CHECK(!copy.matches(book));
+
+    copy.rebuild(book, feed);
+    CHECK(copy.matches(book));
+    CHECK(copy.asks.size() == 19);
+
+    book.processOrderTicks(false, 10050, 7); // seq 22, applied on top of the rebuilt copy
+    feed.publish();
+    copy.drain(feed);
+    CHECK(!copy.stale);
+    CHECK(copy.matches(book));
+    CHECK(feed.dropped() == 4);
+}
@@ -0,0 +1,62 @@
+#include "MonteCarlo.hpp"
+#include "TestHarness.hpp"
+#include <vector>
+
+namespace {
+
+std::vector<double> sampleReturns() {
+    std::vector<double> returns;
+    for (int i = 0; i < 500; ++i) returns.push_back(static_cast<double>(i * 37 % 101) - 50.0);
+    return returns;
+}
+
+bool sameDistribution(const Distribution& a, const Distribution& b) {
+    return a.mean == b.mean && a.stdDev == b.stdDev && a.p5 == b.p5 && a.p50 == b.p50 && a.p95 == b.p95;
+}
+
+} // namespace
+
+// The report is a function of the seed alone: bit-identical whatever the thread count
+TEST(MonteCarlo, DeterministicAcrossThreadCounts) {
+    std::vector<double> returns = sampleReturns();
+    MonteCarloSpec spec;
+    spec.samples = 2000;
+    spec.seed = 7;
+    std::string error;
+
+    spec.threads = 1;
+    MonteCarloReport serial;
+    REQUIRE(bootstrapReturns(returns, spec, serial, error));
+    for (unsigned threads : {2u, 3u, 8u}) {
+        spec.threads = threads;
+        MonteCarloReport parallel;
+        REQUIRE(bootstrapReturns(returns, spec, parallel, error));
+        CHECK(sameDistribution(serial.sharpe, parallel.sharpe));
+        CHECK(sameDistribution(serial.totalPnL, parallel.totalPnL));
+        CHECK(sameDistribution(serial.maxDrawdown, parallel.maxDrawdown));
+        CHECK(serial.lossProbability == parallel.lossProbability);
+    }
+
+    spec.seed = 8;
+    MonteCarloReport reseeded;
+    REQUIRE(bootstrapReturns(returns, spec, reseeded, error));
+    CHECK(!sameDistribution(serial.totalPnL, reseeded.totalPnL));
+}
+
+TEST(MonteCarlo, ObservedPathAndBlockLength) {
+    std::vector<double> returns = {1.0, -2.0, 3.0, -1.0, 0.5, 2.0, -4.0, 1.0};
+    MonteCarloSpec spec;
+    spec.samples = 100;
+    MonteCarloReport report;
+    std::string error;
+    REQUIRE(bootstrapReturns(returns, spec, report, error));
+    CHECK(report.trades == 8);
+    CHECK(report.blockLength == 2); // cube root of 8
+    CHECK(report.observedPnL == 0.5);
+    CHECK(report.observedMaxDrawdown == 4.0); // peak 3.5 after trade 6, trough -0.5 after 7
+
+    MonteCarloReport failed;
+    CHECK(!bootstrapReturns(std::vector<double>{1.0}, spec, failed, error));
+    spec.samples = 0;
+    CHECK(!bootstrapReturns(returns, spec, failed, error));
+}
@@ -0,0 +1,145 @@
+#include "OrderBook.hpp"
+#include "PriceLadder.hpp"
+#include "ReferenceBook.hpp"
+#include "TestHarness.hpp"
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Records fills and keeps every level the book reports, so the whole book can be compared
+// and not just the top of it
+struct RecordingListener {
+    std::vector<Trade>* trades;
+    std::map<Price, Qty>* bidLevels;
+    std::map<Price, Qty>* askLevels;
+
+    void onTrade(const Trade& trade) { trades->push_back(trade); }
+    void onAdd(uint64_t, bool, Price, Qty) {}
+    void onCancel(uint64_t, bool, Price, Qty) {}
+    void onLevelChange(bool isBid, Price price, Qty newTotalSize) {
+        auto& levels = isBid ? *bidLevels : *askLevels;
+        if (newTotalSize == 0) levels.erase(price);
+        else levels[price] = newTotalSize;
+    }
+};
+
+bool sameTrades(const std::vector<Trade>& a, const std::vector<Trade>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].aggressorId != b[i].aggressorId || a[i].restingId != b[i].restingId || a[i].price != b[i].price ||
+            a[i].size != b[i].size || a[i].aggressorIsBuy != b[i].aggressorIsBuy) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Levels>
+bool sameLevels(const Levels& reported, const std::vector<std::pair<Price, Qty>>& expected) {
+    if (reported.size() != expected.size()) return false;
+    for (const auto& [price, size] : expected) {
+        auto it = reported.find(price);
+        if (it == reported.end() || it->second != size) return false;
+    }
+    return true;
+}
+
+bool sameDepth(std::span<const DepthLevel> depth, const std::vector<std::pair<Price, Qty>>& expected) {
+    if (depth.size() != std::min(expected.size(), OrderBook::kDepthLevels)) return false;
+    for (size_t i = 0; i < depth.size(); ++i) {
+        if (depth[i].price != expected[i].first || depth[i].size != expected[i].second) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// Random adds, batches, cancels and amends, with the odd order priced far enough from the
+// touch to land outside the ladder window, checked against ReferenceBook after every step
+TEST(OrderBook, MatchesReferenceBook) {
+    for (uint64_t seed = 0; seed < 8; ++seed) {
+        std::mt19937_64 rng(seed);
+        std::vector<Trade> trades;
+        std::map<Price, Qty> bidLevels, askLevels;
+        BasicOrderBook<RecordingListener> book(SymbolSpec{"BTCUSD", 0.01, 1e-8}, 1024,
+                                               RecordingListener{&trades, &bidLevels, &askLevels});
+        ReferenceBook reference;
+        std::vector<uint64_t> ids;
+        Price mid = 6000000 + static_cast<Price>(seed) * 3700;
+
+        for (int step = 0; step < 20000; ++step) {
+            const unsigned op = rng() % 10;
+            const bool isBuy = rng() & 1;
+            Price offset = static_cast<Price>(rng() % 200) - 100;
+            if (rng() % 40 == 0) offset = static_cast<Price>(rng() % 20000000) - 10000000;
+            mid += static_cast<Price>(rng() % 3) - 1;
+            Price price = std::max<Price>(1, mid + offset);
+            Qty qty = 1 + static_cast<Qty>(rng() % 50);
+
+            if (op == 5) {
+                OrderRequest requests[3];
+                for (OrderRequest& request : requests) {
+                    request.isBuy = rng() & 1;
+                    request.price = mid + static_cast<Price>(rng() % 200) - 100;
+                    request.size = 1 + static_cast<Qty>(rng() % 50);
+                }
+                auto results = book.processBatch(requests);
+                for (size_t k = 0; k < 3; ++k) {
+                    uint64_t expectedId = reference.add(requests[k].isBuy, requests[k].price, requests[k].size);
+                    Qty resting = reference.resting(expectedId);
+                    REQUIRE(results[k].orderId == expectedId);
+                    REQUIRE(results[k].resting == resting);
+                    REQUIRE(results[k].filled == requests[k].size - resting);
+                    ids.push_back(expectedId);
+                }
+            } else if (op < 6 || ids.empty()) {
+                uint64_t orderId = book.processOrderTicks(isBuy, price, qty);
+                REQUIRE(orderId == reference.add(isBuy, price, qty));
+                ids.push_back(orderId);
+            } else if (op < 8) {
+                uint64_t orderId = ids[rng() % ids.size()];
+                REQUIRE(book.cancelOrder(orderId) == reference.cancel(orderId));
+            } else {
+                uint64_t orderId = ids[rng() % ids.size()];
+                if (rng() % 20 == 0) qty = 0;
+                REQUIRE(book.amendOrderTicks(orderId, price, qty) == reference.amend(orderId, price, qty));
+            }
+
+            REQUIRE(sameTrades(trades, reference.trades));
+            trades.clear();
+            reference.trades.clear();
+            REQUIRE(book.bestBidTicks() == (reference.bestBid() == ReferenceBook::kNone ? PriceLadder::kNoTick
+                                                                                         : reference.bestBid()));
+            REQUIRE(book.bestAskTicks() == (reference.bestAsk() == ReferenceBook::kNone ? PriceLadder::kNoTick
+                                                                                         : reference.bestAsk()));
+            auto referenceBids = reference.bidLevels();
+            auto referenceAsks = reference.askLevels();
+            REQUIRE(sameDepth(book.bidDepth(), referenceBids));
+            REQUIRE(sameDepth(book.askDepth(), referenceAsks));
+            if (step % 101 == 0) {
+                REQUIRE(sameLevels(bidLevels, referenceBids));
+                REQUIRE(sameLevels(askLevels, referenceAsks));
+            }
+        }
+    }
+}
+
+// Ids restart at 1 after a reset, so none of the previous run's may still be found, whether
+// the index was emptied id by id (few resting) or wiped whole (many)
+TEST(OrderBook, ResetLeavesNoStaleIds) {
+    OrderBook book(SymbolSpec{"BTCUSD", 0.01, 1e-8}, 64);
+    for (int i = 0; i < 5; ++i) book.processOrderTicks(true, 10000 - i, 10);
+    book.reset();
+    CHECK(book.processOrderTicks(false, 10100, 10) == 1);
+    CHECK(book.processOrderTicks(false, 10101, 10) == 2);
+    CHECK(!book.cancelOrder(3));
+    CHECK(book.cancelOrder(1));
+
+    for (int i = 0; i < 40; ++i) book.processOrderTicks(true, 10000 - i, 10);
+    book.reset();
+    CHECK(!book.cancelOrder(30));
+    CHECK(book.bestBidTicks() == PriceLadder::kNoTick);
+    CHECK(book.bestAskTicks() == PriceLadder::kNoTick);
+}
@@ -0,0 +1,109 @@
+#include "PositionLedger.hpp"
+#include "TestHarness.hpp"
+#include <cmath>
+
+namespace {
+
+const SymbolSpec kSpec{"BTCUSD", 0.01, 1e-8};
+constexpr Qty kOneBtc = 100000000; // lots
+
+bool near(double a, double b) { return std::fabs(a - b) < 1e-9; }
+
+} // namespace
+
+// Every number below is worked out by hand from the fills (prices in dollars, sizes in BTC)
+TEST(PositionLedger, PnLFromFills) {
+    PositionLedger ledger(kSpec, FeeSchedule{0.001, 0.002}, 4);
+    LedgerBook book(kSpec, 1024, LedgerListener{&ledger});
+
+    // Someone offers 1 BTC at 100.00; we lift 0.5 of it: long 0.5 @ 100, taker fee 0.002 * 50
+    book.processOrderTicks(false, 10000, kOneBtc);
+    uint64_t buy = ledger.submit(book, true, 10050, kOneBtc / 2);
+    CHECK(!ledger.working(buy));
+    CHECK(ledger.position() == kOneBtc / 2);
+    CHECK(near(ledger.averageEntry(), 100.0));
+    CHECK(near(ledger.fees(), 0.1));
+
+    // We offer 0.5 at 101.00; a buyer takes the other 0.5 at 100 and 0.2 of ours: long 0.3,
+    // realized (101 - 100) * 0.2 = 0.2, maker fee 0.001 * 101 * 0.2 = 0.0202
+    uint64_t sell = ledger.submit(book, false, 10100, kOneBtc / 2);
+    CHECK(ledger.working(sell));
+    book.processOrderTicks(true, 10100, kOneBtc / 2 + kOneBtc / 5);
+    CHECK(ledger.position() == kOneBtc * 3 / 10);
+    CHECK(near(ledger.realizedPnL(), 0.2));
+    CHECK(near(ledger.fees(), 0.1202));
+
+    // No bids yet, so the mark stays at the first fill; then a bid at 98 gives mid 99.50
+    ledger.mark(book.bestBidTicks(), book.bestAskTicks());
+    CHECK(near(ledger.markPrice(), 100.0));
+    book.processOrderTicks(true, 9800, kOneBtc);
+    ledger.mark(book.bestBidTicks(), book.bestAskTicks());
+    CHECK(near(ledger.markPrice(), 99.5));
+    CHECK(near(ledger.unrealizedPnL(), -0.15));
+
+    // Pull the rest of the offer, then hit the 98 bid for 0.5: closes 0.3 at a loss of
+    // 0.6 and opens short 0.2 @ 98, taker fee 0.002 * 98 * 0.5 = 0.098
+    CHECK(ledger.cancel(book, sell));
+    CHECK(!ledger.working(sell));
+    ledger.submit(book, false, 9800, kOneBtc / 2);
+    CHECK(ledger.position() == -kOneBtc / 5);
+    CHECK(near(ledger.averageEntry(), 98.0));
+    CHECK(near(ledger.realizedPnL(), -0.4));
+    CHECK(near(ledger.fees(), 0.2182));
+
+    // Nothing is offered any more, so the short stays marked at the last mid of 99.50:
+    // unrealized is (98 - 99.5) * 0.2
+    ledger.mark(book.bestBidTicks(), book.bestAskTicks());
+    CHECK(near(ledger.unrealizedPnL(), -0.3));
+    CHECK(near(ledger.equity(), -0.4 - 0.3 - 0.2182));
+
+    const PositionLedger::Counters& counters = ledger.stats();
+    CHECK(counters.fills == 3);
+    CHECK(counters.makerFills == 1);
+    CHECK(counters.closingFills == 2);
+    CHECK(counters.winningCloses == 1);
+    CHECK(near(ledger.tradedQty(), 1.2));
+}
+
+TEST(PositionLedger, RefusesPastCapacity) {
+    PositionLedger ledger(kSpec, FeeSchedule{}, 4);
+    LedgerBook book(kSpec, 64, LedgerListener{&ledger});
+    for (Price tick = 5000; tick < 5004; ++tick) CHECK(ledger.submit(book, true, tick, kOneBtc) != 0);
+    CHECK(ledger.submit(book, true, 4000, kOneBtc) == 0);
+    CHECK(book.bestBidTicks() == 5003);
+
+    ledger.reset();
+    CHECK(ledger.position() == 0);
+    CHECK(ledger.equity() == 0);
+    CHECK(ledger.submit(book, true, 4000, kOneBtc) != 0);
+}
+
+// A re-priced order is pulled and resubmitted under the same id; its fills must still be
+// the strategy's, both those on the way back in and those after it rests again
+TEST(PositionLedger, AmendKeepsTheOrder) {
+    PositionLedger ledger(kSpec, FeeSchedule{}, 4);
+    LedgerBook book(kSpec, 64, LedgerListener{&ledger});
+    book.processOrderTicks(false, 10100, kOneBtc / 10);
+
+    // Bid 1 BTC at 99, move it to 101: 0.1 fills on the way in, 0.9 rests
+    uint64_t bid = ledger.submit(book, true, 9900, kOneBtc);
+    CHECK(ledger.amend(book, bid, 10100, kOneBtc));
+    CHECK(ledger.position() == kOneBtc / 10);
+    CHECK(ledger.working(bid));
+    CHECK(book.bestBidTicks() == 10100);
+
+    // Shrinking in place keeps the claim on what is left, and a seller fills it all
+    CHECK(ledger.amend(book, bid, 10100, kOneBtc / 2));
+    CHECK(ledger.working(bid));
+    book.processOrderTicks(false, 10100, kOneBtc);
+    CHECK(ledger.position() == kOneBtc / 10 + kOneBtc / 2);
+    CHECK(!ledger.working(bid));
+    CHECK(ledger.stats().fills == 2);
+
+    // Amending to nothing cancels, and an order that isn't working can't be amended
+    uint64_t ask = ledger.submit(book, false, 10500, kOneBtc);
+    CHECK(ledger.amend(book, ask, 10500, 0));
+    CHECK(!ledger.working(ask));
+    CHECK(!ledger.amend(book, ask, 10400, kOneBtc));
+    CHECK(!ledger.amend(book, bid, 10100, kOneBtc));
+}
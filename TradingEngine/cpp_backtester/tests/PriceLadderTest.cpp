@@ -0,0 +1,76 @@
+#include "OrderBook.hpp"
+#include "PriceLadder.hpp"
+#include "TestHarness.hpp"
+
+// A level thousands of dollars from the touch goes to the overflow map instead of
+// stretching the window, and comes back as the best price once the levels ahead of it trade
+TEST(PriceLadder, FarLevelsOverflowAndPromote) {
+    PriceLadder bids(true);
+    const Price touch = 6000000; // $60,000.00 in cents
+    for (Price tick = touch; tick > touch - 100; --tick) {
+        bids.levelAt(tick).orderCount = 1;
+        bids.activate(tick);
+    }
+    const Price far = 1; // one cent
+    bids.levelAt(far).orderCount = 1;
+    bids.activate(far);
+    CHECK(bids.overflowCount() == 1);
+    CHECK(bids.levelCount() == 101);
+    CHECK(bids.bestTick() == touch);
+
+    size_t visited = 0;
+    Price last = 0;
+    bids.forEachLevel([&](const PriceLevel& level) {
+        ++visited;
+        last = level.price;
+        return true;
+    });
+    CHECK(visited == 101);
+    CHECK(last == far);
+
+    for (Price tick = touch; tick > touch - 100; --tick) {
+        CHECK(bids.nextWorseTick(tick) == (tick == touch - 99 ? far : tick - 1));
+        bids.levelAt(tick).orderCount = 0;
+        bids.deactivate(tick);
+    }
+    CHECK(bids.bestTick() == far);
+    CHECK(bids.overflowCount() == 0);
+    CHECK(bids.bestLevel().price == far);
+}
+
+// A new best price far from the rest of the book moves the window to itself and spills
+// the old levels into overflow
+TEST(PriceLadder, FarBetterPriceSpillsOldLevels) {
+    PriceLadder asks(false);
+    for (Price tick = 99999900; tick < 99999910; ++tick) {
+        asks.levelAt(tick).orderCount = 1;
+        asks.activate(tick);
+    }
+    asks.levelAt(6000000).orderCount = 1;
+    asks.activate(6000000);
+    CHECK(asks.bestTick() == 6000000);
+    CHECK(asks.overflowCount() == 10);
+    CHECK(asks.nextWorseTick(6000000) == 99999900);
+    CHECK(asks.levelAtTick(99999905).orderCount == 1);
+}
+
+// Orders on both sides of the window, and far outside it, trade in price order as one book
+TEST(PriceLadder, FarOrdersMatchAcrossTheWindow) {
+    OrderBook book(SymbolSpec{"BTCUSD", 0.01, 1e-8}, 1024);
+    for (int i = 0; i < 100; ++i) {
+        book.processOrderTicks(true, 6000000 - i, 10);
+        book.processOrderTicks(false, 6000100 + i, 10);
+    }
+    book.processOrderTicks(true, 1, 5);
+    book.processOrderTicks(false, 99999900, 5);
+    CHECK(book.bestBidTicks() == 6000000);
+    CHECK(book.bestAskTicks() == 6000100);
+
+    // Sweep every bid, including the one-cent one
+    book.processOrderTicks(false, 1, 1005 + 7);
+    CHECK(book.bestBidTicks() == PriceLadder::kNoTick);
+    CHECK(book.bestAskTicks() == 1);
+    REQUIRE(book.askDepth().size() == OrderBook::kDepthLevels);
+    CHECK(book.askDepth()[0].size == 7);
+    CHECK(book.askDepth()[1].price == 6000100);
+}
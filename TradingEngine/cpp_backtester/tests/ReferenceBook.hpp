@@ -0,0 +1,139 @@
+#ifndef REFERENCEBOOK_HPP
+#define REFERENCEBOOK_HPP
+
+#include "BookEvents.hpp"
+#include "SymbolSpec.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// The obvious price-time priority book: std::map of price -> FIFO per side, ids assigned
+// from 1, the same amend rules as BasicOrderBook. Slow, but small enough to trust, so the
+// real book is tested by running both on the same requests and comparing.
+class ReferenceBook {
+public:
+    struct Resting {
+        uint64_t orderId;
+        Qty qty;
+    };
+
+    std::vector<Trade> trades; // every fill so far, in execution order
+
+    uint64_t add(bool isBuy, Price price, Qty qty) {
+        uint64_t orderId = nextOrderId++;
+        submit(orderId, isBuy, price, qty);
+        return orderId;
+    }
+
+    bool cancel(uint64_t orderId) {
+        auto it = located.find(orderId);
+        if (it == located.end()) return false;
+        auto [isBuy, price] = it->second;
+        located.erase(it);
+        if (isBuy) erase(bids, price, orderId);
+        else erase(asks, price, orderId);
+        return true;
+    }
+
+    bool amend(uint64_t orderId, Price price, Qty qty) {
+        auto it = located.find(orderId);
+        if (it == located.end()) return false;
+        if (qty <= 0) return cancel(orderId);
+        auto [isBuy, oldPrice] = it->second;
+        Resting* order = isBuy ? find(bids, oldPrice, orderId) : find(asks, oldPrice, orderId);
+        if (price == oldPrice && qty <= order->qty) {
+            order->qty = qty;
+            return true;
+        }
+        cancel(orderId);
+        submit(orderId, isBuy, price, qty);
+        return true;
+    }
+
+    // Unfilled quantity of a resting order, 0 if it isn't resting
+    Qty resting(uint64_t orderId) {
+        auto it = located.find(orderId);
+        if (it == located.end()) return 0;
+        auto [isBuy, price] = it->second;
+        return (isBuy ? find(bids, price, orderId) : find(asks, price, orderId))->qty;
+    }
+
+    Price bestBid() const { return bids.empty() ? kNone : bids.begin()->first; }
+    Price bestAsk() const { return asks.empty() ? kNone : asks.begin()->first; }
+
+    // Aggregate (price, size) per level, best first
+    std::vector<std::pair<Price, Qty>> bidLevels() const { return levels(bids); }
+    std::vector<std::pair<Price, Qty>> askLevels() const { return levels(asks); }
+
+    static constexpr Price kNone = INT64_MIN;
+
+private:
+    std::map<Price, std::deque<Resting>, std::greater<Price>> bids;
+    std::map<Price, std::deque<Resting>> asks;
+    std::unordered_map<uint64_t, std::pair<bool, Price>> located; // id -> (isBuy, price)
+    uint64_t nextOrderId = 1;
+
+    void submit(uint64_t orderId, bool isBuy, Price price, Qty qty) {
+        if (isBuy) match(asks, orderId, true, price, qty);
+        else match(bids, orderId, false, price, qty);
+        if (qty <= 0) return;
+        if (isBuy) bids[price].push_back({orderId, qty});
+        else asks[price].push_back({orderId, qty});
+        located[orderId] = {isBuy, price};
+    }
+
+    template <typename Side>
+    void match(Side& side, uint64_t orderId, bool isBuy, Price price, Qty& qty) {
+        while (qty > 0 && !side.empty()) {
+            auto level = side.begin();
+            if (isBuy ? price < level->first : price > level->first) break;
+            auto& queue = level->second;
+            while (qty > 0 && !queue.empty()) {
+                Resting& head = queue.front();
+                Qty fill = std::min(qty, head.qty);
+                trades.push_back(Trade{orderId, head.orderId, level->first, fill, isBuy});
+                qty -= fill;
+                head.qty -= fill;
+                if (head.qty == 0) {
+                    located.erase(head.orderId);
+                    queue.pop_front();
+                }
+            }
+            if (queue.empty()) side.erase(level);
+        }
+    }
+
+    template <typename Side>
+    static Resting* find(Side& side, Price price, uint64_t orderId) {
+        for (Resting& order : side[price]) {
+            if (order.orderId == orderId) return &order;
+        }
+        return nullptr;
+    }
+
+    template <typename Side>
+    static void erase(Side& side, Price price, uint64_t orderId) {
+        auto& queue = side[price];
+        queue.erase(std::find_if(queue.begin(), queue.end(),
+                                 [orderId](const Resting& order) { return order.orderId == orderId; }));
+        if (queue.empty()) side.erase(price);
+    }
+
+    template <typename Side>
+    static std::vector<std::pair<Price, Qty>> levels(const Side& side) {
+        std::vector<std::pair<Price, Qty>> out;
+        for (const auto& [price, queue] : side) {
+            Qty total = 0;
+            for (const Resting& order : queue) total += order.qty;
+            out.emplace_back(price, total);
+        }
+        return out;
+    }
+};
+
+#endif
@@ -0,0 +1,127 @@
+#include "Strategies.hpp"
+#include "TestHarness.hpp"
+#include <cmath>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+const SymbolSpec kSpec{"BTCUSD", 0.01, 1e-8};
+constexpr Qty kOneBtc = 100000000; // lots
+
+bool near(double a, double b) { return std::fabs(a - b) < 1e-9; }
+
+} // namespace
+
+// Prices in dollars, sizes in BTC; every number is worked out by hand from the fills
+TEST(Strategies, SpreadArbitrageEarnsTheSpread) {
+    PositionLedger ledger(kSpec, FeeSchedule{0.001, 0.002});
+    LedgerBook book(kSpec, 1024, LedgerListener{&ledger});
+    SpreadArbitrage strategy;
+    strategy.quoteLots = kOneBtc / 10;
+    strategy.maxPositionLots = kOneBtc / 10;
+
+    // Two levels a side; the strategy joins the touch behind the 1 BTC already there
+    book.processOrderTicks(true, 10000, kOneBtc);
+    book.processOrderTicks(true, 9900, kOneBtc);
+    book.processOrderTicks(false, 10100, kOneBtc);
+    book.processOrderTicks(false, 10200, kOneBtc);
+    strategy.act(book, ledger, true, 10000);
+    CHECK(ledger.working(strategy.bidId));
+    CHECK(ledger.working(strategy.askId));
+
+    // A seller takes all of 100.00: long 0.1 @ 100, maker fee 0.001 * 100 * 0.1 = 0.01
+    book.processOrderTicks(false, 10000, kOneBtc + kOneBtc / 10);
+    CHECK(ledger.position() == kOneBtc / 10);
+    CHECK(near(ledger.fees(), 0.01));
+
+    // At the limit, so only the ask is quoted, and it keeps its place in the 101.00 queue
+    const uint64_t ask = strategy.askId;
+    strategy.act(book, ledger, false, 10000);
+    CHECK(!ledger.working(strategy.bidId));
+    CHECK(strategy.askId == ask);
+
+    // A buyer takes all of 101.00: flat, realized (101 - 100) * 0.1 = 0.1, maker fee
+    // 0.001 * 101 * 0.1 = 0.0101
+    book.processOrderTicks(true, 10100, kOneBtc + kOneBtc / 10);
+    CHECK(ledger.position() == 0);
+    CHECK(near(ledger.realizedPnL(), 0.1));
+    CHECK(near(ledger.fees(), 0.0201));
+    CHECK(near(ledger.equity(), 0.0799));
+
+    // Flat again, so both sides are quoted at the new touch
+    strategy.act(book, ledger, true, 10100);
+    CHECK(ledger.working(strategy.bidId));
+    CHECK(ledger.working(strategy.askId));
+    CHECK(book.bestBidTicks() == 9900);
+    CHECK(book.bestAskTicks() == 10200);
+
+    const PositionLedger::Counters& counters = ledger.stats();
+    CHECK(counters.fills == 2);
+    CHECK(counters.makerFills == 2);
+    CHECK(counters.winningCloses == 1);
+}
+
+TEST(Strategies, MomentumHoldsAFixedPosition) {
+    PositionLedger ledger(kSpec, FeeSchedule{0.001, 0.002});
+    LedgerBook book(kSpec, 1024, LedgerListener{&ledger});
+    Momentum strategy{0.01, 0.01, kOneBtc / 5};
+
+    book.processOrderTicks(true, 9900, kOneBtc);
+    book.processOrderTicks(false, 10000, kOneBtc);
+
+    // Buying flow: lift 0.2 at 100.00, taker fee 0.002 * 100 * 0.2 = 0.04
+    strategy.act(book, ledger, true, 10000);
+    CHECK(ledger.position() == kOneBtc / 5);
+    CHECK(near(ledger.averageEntry(), 100.0));
+    CHECK(near(ledger.fees(), 0.04));
+
+    // More buying flow leaves the position where it is
+    strategy.act(book, ledger, true, 10000);
+    CHECK(ledger.stats().ordersSubmitted == 1);
+
+    // Selling flow: hit 99.00 for 0.4, closing 0.2 at (99 - 100) * 0.2 = -0.2 and going
+    // short 0.2 @ 99; taker fee 0.002 * 99 * 0.4 = 0.0792
+    strategy.act(book, ledger, false, 9900);
+    CHECK(ledger.position() == -kOneBtc / 5);
+    CHECK(near(ledger.averageEntry(), 99.0));
+    CHECK(near(ledger.realizedPnL(), -0.2));
+    CHECK(near(ledger.fees(), 0.1192));
+
+    // Bid 99.00 has 0.6 left and ask 100.00 0.8, so mid 99.50: unrealized (99 - 99.5) * 0.2
+    ledger.mark(book.bestBidTicks(), book.bestAskTicks());
+    CHECK(near(ledger.unrealizedPnL(), -0.1));
+    CHECK(near(ledger.equity(), -0.2 - 0.1 - 0.1192));
+}
+
+// Each name reaches its own type, once; anything unknown is refused (candles) or falls
+// back to momentum (order books), with sizes scaled by `aggression` up front
+TEST(Strategies, DispatchByName) {
+    const char* names[] = {"sma_crossover", "rsi_mean_reversion", "bollinger_breakout", "macd_signal"};
+    for (const char* name : names) {
+        int calls = 0;
+        bool known = dispatchCandleStrategy(name, [&](auto strategy) {
+            ++calls;
+            CHECK(std::string(decltype(strategy)::kName) == name);
+        });
+        CHECK(known);
+        CHECK(calls == 1);
+    }
+    CHECK(!dispatchCandleStrategy("momentum", [](auto) { CHECK(false); }));
+
+    // Both branches instantiate the callback, so it reports the type and its order size
+    std::string name;
+    Qty lots = 0;
+    auto record = [&](auto strategy) {
+        using Strategy = decltype(strategy);
+        name = Strategy::kName;
+        if constexpr (std::is_same_v<Strategy, SpreadArbitrage>) lots = strategy.quoteLots;
+        else lots = strategy.positionLots;
+    };
+    dispatchOrderbookStrategy("spread_arbitrage", 2.0, 0.01, 0.01, record);
+    CHECK(name == "spread_arbitrage");
+    CHECK(lots == 2 * SpreadArbitrage{}.quoteLots);
+    dispatchOrderbookStrategy("no_such_strategy", 0.5, 0.01, 0.01, record);
+    CHECK(name == "momentum");
+    CHECK(lots == Momentum{}.positionLots / 2);
+}
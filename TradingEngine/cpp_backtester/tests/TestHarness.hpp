@@ -0,0 +1,62 @@
+#ifndef TESTHARNESS_HPP
+#define TESTHARNESS_HPP
+
+#include <string>
+#include <vector>
+
+// A deliberately small test runner, so the suite builds with nothing but the compiler.
+// TEST(Suite, Name) { ... } registers a case; CHECK(cond) records a failure and carries
+// on, REQUIRE(cond) records it and leaves the case. `backtester_tests Suite` runs the
+// cases of one suite (that is what each ctest entry does); no argument runs them all.
+
+namespace testing {
+
+struct TestCase {
+    const char* suite;
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& registry();
+void reportFailure(const char* expression, const char* file, int line);
+
+struct Registrar {
+    Registrar(const char* suite, const char* name, void (*run)()) { registry().push_back({suite, name, run}); }
+};
+
+// A scratch file path unique to this process, removed by the destructor
+class TempPath {
+public:
+    explicit TempPath(const std::string& name);
+    ~TempPath();
+
+    TempPath(const TempPath&) = delete;
+    TempPath& operator=(const TempPath&) = delete;
+
+    const std::string& str() const { return path; }
+
+private:
+    std::string path;
+};
+
+} // namespace testing
+
+#define TEST(suite, name)                                                                   \
+    static void suite##_##name();                                                           \
+    static const testing::Registrar suite##_##name##_registrar(#suite, #name, suite##_##name); \
+    static void suite##_##name()
+
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        if (!(cond)) testing::reportFailure(#cond, __FILE__, __LINE__);          \
+    } while (0)
+
+#define REQUIRE(cond)                                                            \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            testing::reportFailure(#cond, __FILE__, __LINE__);                   \
+            return;                                                              \
+        }                                                                        \
+    } while (0)
+
+#endif
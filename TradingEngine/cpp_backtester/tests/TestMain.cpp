@@ -0,0 +1,53 @@
+#include "TestHarness.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <unistd.h>
+
+namespace testing {
+
+namespace {
+size_t failures = 0;
+}
+
+std::vector<TestCase>& registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+void reportFailure(const char* expression, const char* file, int line) {
+    std::fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", file, line, expression);
+    ++failures;
+}
+
+TempPath::TempPath(const std::string& name)
+    : path((std::filesystem::temp_directory_path() / ("backtester_test_" + std::to_string(getpid()) + "_" + name))
+               .string()) {}
+
+TempPath::~TempPath() {
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+    std::filesystem::remove(path + ".tmp", ignored);
+}
+
+} // namespace testing
+
+int main(int argc, char** argv) {
+    const char* suite = argc > 1 ? argv[1] : nullptr;
+    size_t ran = 0, failed = 0;
+    for (const testing::TestCase& test : testing::registry()) {
+        if (suite && std::strcmp(suite, test.suite) != 0) continue;
+        size_t before = testing::failures;
+        test.run();
+        ++ran;
+        bool ok = testing::failures == before;
+        if (!ok) ++failed;
+        std::printf("[%s] %s.%s\n", ok ? "  OK  " : " FAIL ", test.suite, test.name);
+    }
+    if (ran == 0) {
+        std::fprintf(stderr, "No tests in suite '%s'\n", suite ? suite : "");
+        return 1;
+    }
+    std::printf("%zu/%zu passed\n", ran - failed, ran);
+    return failed == 0 ? 0 : 1;
+}